@@ -25,8 +25,6 @@
     <IMAGE id="IMG_ID_GX_TETRIS_DIGIT_7">TETRIS_IMG_PATH"digit7"GX_IMG_TYPE</IMAGE>
     <IMAGE id="IMG_ID_GX_TETRIS_DIGIT_8">TETRIS_IMG_PATH"digit8"GX_IMG_TYPE</IMAGE>
     <IMAGE id="IMG_ID_GX_TETRIS_DIGIT_9">TETRIS_IMG_PATH"digit9"GX_IMG_TYPE</IMAGE>
-    <IMAGE id="IMG_ID_GX_TETRIS_DIGIT_9">TETRIS_IMG_PATH"digit9"GX_IMG_TYPE</IMAGE>
-    <IMAGE id="IMG_ID_GX_TETRIS_SCORE">TETRIS_IMG_PATH"TetrisScore"GX_IMG_TYPE</IMAGE>
 	<IMAGE id="IMG_ID_GX_TETRIS_START">TETRIS_IMG_PATH"TetrisStart"GX_IMG_TYPE</IMAGE>
 	<IMAGE id="IMG_ID_GX_TETRIS_LEVEL">TETRIS_IMG_PATH"TetrisLevel"GX_IMG_TYPE</IMAGE>
 	<IMAGE id="IMG_ID_GX_TETRIS_SCORE">TETRIS_IMG_PATH"TetrisScore"GX_IMG_TYPE</IMAGE>
@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+#
+# img2bundle.py
+#
+# Converts the Tetris images listed in Game.res into TetrisBundle.h, one
+# blob of pre-decoded images behind a compact index:
+#
+#     python3 GameImages/img2bundle.py Game.res TetrisBundle.h [IMG_ID ...]
+#
+# Only the opaque pixels are kept. Every row of an image is a list of
+# (skip, length) spans, so the blitter draws a row with one memcpy per span
+# and never tests a pixel. A pixel is transparent if its alpha is below 128
+# or if it has the colour key of the original gui_show_transparent_image
+# calls (black).
+#
+# An image is stored in whichever of the two formats is smaller:
+#
+#   BUNDLE_SPANS565   U16 span bytes, spans, pad to even, RGB565 pixels
+#   BUNDLE_SPANS8     U16 span bytes, U8 colours - 1, U8 0, RGB565 palette,
+#                     spans, a palette index per pixel
+#
+# BUNDLE_SPANS8 is expanded into BUNDLE_SPANS565 in RAM on first use.
+# Identical blobs are stored once, all U16 are little endian.
+#
+# Needs nothing but a Python 3 interpreter.
+#
+
+import re
+import struct
+import sys
+import zlib
+
+# the images the game draws itself, the menu icons belong to the framework
+DEFAULT_IMAGES = [
+    "IMG_ID_GX_TETRIS_SPLASH",
+    "IMG_ID_GX_TETRIS_DIGIT_0", "IMG_ID_GX_TETRIS_DIGIT_1",
+    "IMG_ID_GX_TETRIS_DIGIT_2", "IMG_ID_GX_TETRIS_DIGIT_3",
+    "IMG_ID_GX_TETRIS_DIGIT_4", "IMG_ID_GX_TETRIS_DIGIT_5",
+    "IMG_ID_GX_TETRIS_DIGIT_6", "IMG_ID_GX_TETRIS_DIGIT_7",
+    "IMG_ID_GX_TETRIS_DIGIT_8", "IMG_ID_GX_TETRIS_DIGIT_9",
+    "IMG_ID_GX_TETRIS_GAMESCORE_EN",
+    "IMG_ID_GX_TETRIS_GAMESPEED_EN",
+    "IMG_ID_GX_TETRIS_GAMEPAUSE_EN",
+]
+
+COLOR_KEY = (0, 0, 0)
+
+
+def read_png(path):
+    """Returns width, height and rows of (r, g, b, a)."""
+    data = open(path, "rb").read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG file" % path)
+
+    pos = 8
+    idat = b""
+    palette = []
+    trns = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, length, 3)]
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+    if interlace:
+        raise ValueError("%s: interlaced PNG is not supported" % path)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    bits = depth * channels
+    stride = (width * bits + 7) // 8
+    bpp = max(1, bits // 8)
+    raw = zlib.decompress(idat)
+
+    rows = []
+    prior = bytearray(stride)
+    for y in range(height):
+        line = raw[y * (stride + 1):(y + 1) * (stride + 1)]
+        filt, cur = line[0], bytearray(line[1:])
+        for i in range(stride):
+            a = cur[i - bpp] if i >= bpp else 0
+            b = prior[i]
+            c = prior[i - bpp] if i >= bpp else 0
+            if filt == 1:
+                cur[i] = (cur[i] + a) & 0xff
+            elif filt == 2:
+                cur[i] = (cur[i] + b) & 0xff
+            elif filt == 3:
+                cur[i] = (cur[i] + ((a + b) >> 1)) & 0xff
+            elif filt == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                cur[i] = (cur[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xff
+        prior = cur
+
+        # samples of the row, 16 bit samples keep their high byte
+        if depth < 8:
+            samples = [(cur[(x * depth) // 8] >> (8 - depth - (x * depth) % 8)) & ((1 << depth) - 1)
+                       for x in range(width)]
+        else:
+            step = depth // 8
+            samples = [cur[i] for i in range(0, stride, step)]
+
+        row = []
+        for x in range(width):
+            if ctype == 3:
+                index = samples[x]
+                r, g, b = palette[index]
+                alpha = trns[index] if index < len(trns) else 255
+            elif ctype == 0:
+                r = g = b = samples[x] * 255 // ((1 << depth) - 1)
+                alpha = 255
+            elif ctype == 4:
+                r = g = b = samples[x * 2]
+                alpha = samples[x * 2 + 1]
+            else:
+                r, g, b = samples[x * channels:x * channels + 3]
+                alpha = samples[x * 4 + 3] if ctype == 6 else 255
+            row.append((r, g, b, alpha))
+        rows.append(row)
+    return width, height, rows
+
+
+def read_images(res_path):
+    """IMG_ID -> file name of the unconditional IMAGE entries, first one wins."""
+    images = {}
+    depth = 0
+    for line in open(res_path, encoding="latin-1"):
+        if re.match(r"\s*#\s*if", line):
+            depth += 1
+        elif re.match(r"\s*#\s*endif", line):
+            depth -= 1
+        m = re.search(r'<IMAGE id="(\w+)">TETRIS_IMG_PATH"(\w+)"', line)
+        if m and depth <= 1 and m.group(1) not in images:
+            images[m.group(1)] = m.group(2)
+    return images
+
+
+def le16(value):
+    return [value & 0xff, value >> 8]
+
+
+def encode(width, height, rows):
+    """Returns the smaller blob of the image and its format."""
+    spans = []
+    pixels = []
+    for row in rows:
+        runs = []
+        x = 0
+        while x < width:
+            start = x
+            while x < width and (row[x][3] < 128 or row[x][:3] == COLOR_KEY):
+                x += 1
+            skip = x - start
+            begin = x
+            while x < width and not (row[x][3] < 128 or row[x][:3] == COLOR_KEY):
+                r, g, b, _ = row[x]
+                pixels.append(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+                x += 1
+            if x > begin:
+                runs.append((skip, x - begin))
+        spans.append(len(runs))
+        for skip, length in runs:
+            spans.extend((skip, length))
+
+    direct = le16(len(spans)) + spans + [0] * (len(spans) % 2)
+    for pixel in pixels:
+        direct += le16(pixel)
+
+    palette = sorted(set(pixels))
+    if 0 < len(palette) <= 256:
+        indexed = le16(len(spans)) + [len(palette) - 1, 0]
+        for colour in palette:
+            indexed += le16(colour)
+        indexed += spans + [palette.index(pixel) for pixel in pixels]
+        if len(indexed) < len(direct):
+            return "BUNDLE_SPANS8", indexed
+    return "BUNDLE_SPANS565", direct
+
+
+def main(argv):
+    if len(argv) < 3:
+        print("usage: img2bundle.py Game.res TetrisBundle.h [IMG_ID ...]")
+        return 1
+    res_path, out_path = argv[1], argv[2]
+    wanted = argv[3:] or DEFAULT_IMAGES
+    files = read_images(res_path)
+    folder = re.sub(r"[^/\\]*$", "", res_path) + "GameImages/Tetris/"
+
+    entries = []
+    blobs = {}
+    bundle = []
+    for image_id in wanted:
+        width, height, rows = read_png(folder + files[image_id] + ".png")
+        if width > 255 or height > 255:
+            raise ValueError("%s: larger than 255 pixels" % image_id)
+        kind, blob = encode(width, height, rows)
+        key = bytes(blob)
+        shared = key in blobs
+        if not shared:
+            blobs[key] = len(bundle)
+            bundle += blob + [0] * (len(blob) % 2)
+        entries.append((image_id, width, height, kind, blobs[key], len(blob), shared))
+
+    out = open(out_path, "w", newline="\r\n")
+    out.write("/*\n** Generated by GameImages/img2bundle.py from %s, do not edit.\n**\n"
+              "** %d entries, %d blobs, %d bundle bytes.\n*/\n\n"
+              % (res_path.replace("\\", "/").split("/")[-1], len(entries), len(blobs), len(bundle)))
+    out.write("#ifndef _GAME_TETRIS_BUNDLE_H_\n#define _GAME_TETRIS_BUNDLE_H_\n\n")
+    out.write("typedef enum\n{\n")
+    for entry in entries:
+        out.write("    %s,\n" % entry[0].replace("IMG_ID_GX_TETRIS_", "TETRIS_ASSET_"))
+    out.write("    TETRIS_ASSET_COUNT\n} TetrisAssetEnum;\n\n")
+
+    out.write("const CBundleEntry tetris_bundle_index[TETRIS_ASSET_COUNT] =\n{\n")
+    for image_id, width, height, kind, offset, size, _ in entries:
+        out.write("    {%s, %d, %d, %s, %d, %d},\n" % (image_id, width, height, kind, offset, size))
+    out.write("};\n\n")
+
+    out.write("__align(2)\nconst U8 tetris_bundle[%d] =\n{\n" % len(bundle))
+    for i in range(0, len(bundle), 16):
+        out.write("    " + ", ".join("0x%02x" % v for v in bundle[i:i + 16]) + ",\n")
+    out.write("};\n\n#endif /* _GAME_TETRIS_BUNDLE_H_ */\n")
+    out.close()
+
+    for image_id, width, height, kind, offset, size, shared in entries:
+        print("%-32s %3d x %-3d %-16s %5d bytes%s"
+              % (image_id, width, height, kind, size, " (shared)" if shared else ""))
+    print("%d bundle bytes, %d index bytes" % (len(bundle), len(entries) * 10))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
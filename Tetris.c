@@ -11,6 +11,41 @@
 **
 ** when          who             what, where, why
 ** ----------    ------------    --------------------------------
+** 2026-10-19    me              Arm the splash timer through the frame governor
+** 2026-10-19    me              Single channel loop cut only by rare effects, restarted after them.
+** 2026-10-19    me              Snapshot state, level, timing, piece cells and row maps checked too.
+** 2026-10-19    me              Benchmark on the B key, not on every new game.
+** 2026-10-19    me              Bundle report behind its flag.
+** 2026-10-19    me              One trace event per PC key.
+** 2026-10-19    me              Dropped virtual timers fail the soak and the replay.
+** 2026-10-19    me              Snapshot values checked before they are taken.
+** 2026-10-19    me              Loop pauses and resumes in place, no restart after effects.
+** 2026-10-19    me              Overlay off repaints only its box.
+** 2026-10-19    me              Golden frame verification of the renderer.
+** 2026-10-19    me              Replay recorder and player, virtual clock shared with the soak.
+** 2026-10-19    me              Seeded piece generator in the game state, 7-bag mode.
+** 2026-10-19    me              Soak harness.
+** 2026-10-19    me              Memory accounting, no free of rows never allocated.
+** 2026-10-19    me              Frame-budget watchdog.
+** 2026-10-19    me              Performance overlay.
+** 2026-10-19    me              Binary trace ring in place of hot debug().
+** 2026-10-19    me              Render benchmark across screen sizes.
+** 2026-10-19    me              Logic microbenchmark.
+** 2026-10-19    me              Optional tone renderer.
+** 2026-10-19    me              Background loop, one audio service.
+** 2026-10-19    me              Sound effect scheduler.
+** 2026-10-19    me              Const, deduplicated sound effects.
+** 2026-10-19    me              Indexed asset bundle.
+** 2026-10-19    me              Pre-decoded image atlas.
+** 2026-10-19    me              Top-N leaderboard per level.
+** 2026-10-19    me              Suspend snapshot.
+** 2026-10-19    me              Packed settings record.
+** 2026-10-19    me              Settings cache.
+** 2026-10-19    me              Key latency trace.
+** 2026-10-19    me              In-place next level prompt.
+** 2026-10-19    me              Instant resume from pause.
+** 2026-10-19    me              Frame governor.
+** 2026-10-19    me              Ghost piece.
 ** 2024-11-24	 me				 Success snd
 ** 2024-11-24    me              Resume.
 ** 2024-11-24    me              Pseudo-resume.
@@ -27,7 +62,8 @@
  * (1) The Tetris contains three files.                         
  *    Tetris.c, TetrisDefs.h, TetrisProts.h                                          
  *                                                                
- * (2) Create NVRAM slot in NVRAMEnum.h to store game grade and current game level.
+ * (2) Create NVRAM slot in NVRAMEnum.h to store game grade and current game level,
+ *     and the NVRAM_EF_GX_TETRIS_DATA_LID record (1 x sizeof(CTetrisRecord)).
  *
  * (3) Write generate resouce related code in Game.res
  *
@@ -35,7 +71,9 @@
  *
  * (5) Add __MMI_GAME_TETRIS__ in "MMI_features.h" if you wish to enable this game.
  *
- * (6) Remember to re-generate resource.
+ * (6) Remember to re-generate resource, and TetrisBundle.h when the images
+ *     change: python3 GameImages/img2bundle.py Game.res TetrisBundle.h
+ *     and TetrisResDef.h when the sounds change: python3 music/mid2h.py music TetrisResDef.h
  *******************************************************************************/
 /* 
 **----------------------------------------------------------------------------
@@ -51,12 +89,17 @@
 #include "TetrisProts.h"
 #include "TetrisResDef.h"
 #include "mmi_rp_app_games_def.h"
+#include "TetrisBundle.h"
 
 #ifdef __MMI_GAME_MULTI_LANGUAGE_SUPPORT__      //added for multi-language
 #include "GameProts.h"
 #endif
 
 #include "mmi_frm_nvram_gprot.h" 
+#include "app_datetime.h"
+#if defined(__TETRIS_BENCHMARK__) || defined(__TETRIS_TRACE_EXPORT__)
+#include "fs_gprot.h"
+#endif
 
 #ifdef __MMI_GAME_TETRIS__
 
@@ -72,44 +115,150 @@
 # define SETAEERECT(prc,l,t,w,h)   (prc)->x=(S16)(l),(prc)->y=(S16)(t),(prc)->dx=(S16)(w),(prc)->dy=(S16)(h)
 #define theRowIsDirty( row) ( me->gridRowMap[row] == me->gridRowMask)
 
+/* what differs between configData and NVRAM */
+#define CONFIG_DIRTY_RECORD     0x01    // only the record, e.g. after a migration
+#define CONFIG_DIRTY_LEVEL      0x02
+#define CONFIG_DIRTY_GRID       0x04
+#define CONFIG_DIRTY_SCORE(i)   (0x08 << (i))
+
 #ifndef __MTK_TARGET__
 #define debug(format, ...) printf((format), ##__VA_ARGS__)
 #else
 #define debug(...) kal_prompt_trace(MOD_MMI_MEDIA_APP, __VA_ARGS__)
 #endif
 
-#ifdef __MMI_GAME_MULTICHANNEL_SOUND__
-#define GFX_TETRIS_PLAY_AUDIO(raw_data, size, play_style)                  \
-do{                                                                        \
-   if(GFX.is_aud_on &&                                                     \
-      (srv_prof_is_profile_activated(SRV_PROF_SILENT_MODE) != SRV_PROF_RET_PROFILE_ACTIVATED) && !mmi_gfx_is_background_call())           \
-   {                                                                       \
-      mdi_audio_play_string_with_vol_path_non_block(  (void*)raw_data,     \
-                                                      (U32)size,           \
-                                                      MDI_FORMAT_SMF,      \
-                                                      play_style,          \
-                                                      NULL,                \
-                                                      NULL,                \
-                                                      GFX.aud_volume,      \
-                                                      MDI_DEVICE_SPEAKER2);\
-   }                                                                       \
+/*
+** One writer, the MMI task, and the export runs on it too, so the ring
+** needs no lock: a record is a few stores and the head only grows.
+*/
+#if TETRIS_TRACE_LEVEL > 0
+#define TRACE_EVENT(id, x, y)                                                   \
+do{                                                                             \
+    CTraceEvent *traceRecord = &tetris_trace_ring[tetris_trace_head ++ & ( TRACE_RING_SIZE - 1)]; \
+    traceRecord->time  = drv_get_current_time();                                \
+    traceRecord->event = (U16)(id);                                             \
+    traceRecord->a     = (S32)(x);                                              \
+    traceRecord->b     = (S32)(y);                                              \
 }while(0)
+#endif
+
+#if TETRIS_TRACE_LEVEL >= 1
+#define TRACE1(id, x, y)            TRACE_EVENT(id, x, y)
+#else
+#define TRACE1(id, x, y)
+#endif
+#if TETRIS_TRACE_LEVEL >= 2
+#define TRACE2(id, x, y)            TRACE_EVENT(id, x, y)
+#else
+#define TRACE2(id, x, y)
+#endif
+
+#ifdef __TETRIS_LATENCY_TRACE__
+#define LATENCY_KEY_DOWN(action)    do { TRACE2( TRACE_KEY, action, 0); latencyKeyDown(action); } while(0)
+#define LATENCY_KEY_DONE()          latencyKeyDone()
+#define LATENCY_PRESENTED()         latencyPresented()
+#else
+#define LATENCY_KEY_DOWN(action)    TRACE2( TRACE_KEY, action, 0)
+#define LATENCY_KEY_DONE()
+#define LATENCY_PRESENTED()
+#endif
+
+#ifdef __TETRIS_MEM_ACCOUNT__
+#define TETRIS_CTRL_ALLOC(size)     memoryAlloc( size, __LINE__)
+#define TETRIS_FREE(p)              memoryFree( p, __LINE__)
+#else
+#define TETRIS_CTRL_ALLOC(size)     get_ctrl_buffer( size)
+#define TETRIS_FREE(p)              free_ctrl_buffer( p)
+#endif
+#ifdef __TETRIS_BENCHMARK__
+#define TETRIS_ALLOC(size)          ( tetris_bench_allocs ++, TETRIS_CTRL_ALLOC( size))
+#else
+#define TETRIS_ALLOC(size)          TETRIS_CTRL_ALLOC( size)
+#endif
+
+#ifdef __TETRIS_RENDER_COUNT__
+#define RENDER_COUNT(what, w, h)    ( tetris_render_count.what ++, tetris_render_count.pixels += (U32)(w) * (U32)(h), \
+                                      tetris_render_count.frameStart = tetris_render_count.frameStart ? \
+                                            tetris_render_count.frameStart : drv_get_current_time())
+#else
+#define RENDER_COUNT(what, w, h)
+#endif
+
+#ifdef __TETRIS_VIRTUAL_CLOCK__
+/* the timers of a soak or a replay go to a virtual clock, see virtualStartTimer */
+#define gui_start_timer(elapse, callback)   virtualStartTimer( elapse, (void (*)( void))(callback))
+#define gui_cancel_timer(callback)          virtualCancelTimer( (void (*)( void))(callback))
+#define PIECE_LAUNCHED()                    ( tetris_pieces_launched ++)
+#else
+#define PIECE_LAUNCHED()
+#endif
+
+#ifdef __TETRIS_REPLAY__
+#define REPLAY_START()                      replayStart()
+#define REPLAY_SAVE()                       replaySave()
+#define REPLAY_KEY(code)                    replayKey( code)
+#define REPLAY_KEY_DONE()                   ( g_gx_tetris_replay.depth --)
+#define REPLAY_TICK()                       replayTick()
+#define REPLAY_PIECE()                      replayPiece()
+#else
+#define REPLAY_START()
+#define REPLAY_SAVE()
+#define REPLAY_KEY(code)
+#define REPLAY_KEY_DONE()
+#define REPLAY_TICK()
+#define REPLAY_PIECE()
+#endif
+
+#ifdef __TETRIS_WATCHDOG__
+#define WATCHDOG_ENTER(kind, name)  watchdogEnter( kind, #name)
+#define WATCHDOG_STEP(name)         watchdogStep( #name)
+#define WATCHDOG_LEAVE()            watchdogLeave()
+#else
+#define WATCHDOG_ENTER(kind, name)
+#define WATCHDOG_STEP(name)
+#define WATCHDOG_LEAVE()
+#endif
+
+#ifdef __TETRIS_PERF_HUD__
+#define HUD_TIMER_ARMED(callback, elapse)   hudTimerArmed( callback, elapse)
+#define HUD_TIMER_FIRED(callback)           hudTimerFired( callback)
+#else
+#define HUD_TIMER_ARMED(callback, elapse)
+#define HUD_TIMER_FIRED(callback)
+#endif
+
+#ifdef __TETRIS_TONE_RENDERER__
+#define TONE_SELECT(list)           tones = list; toneCount = list##_count
+#define TONE_PUT32(p, v)            do { (p)[0] = (U8)(v); (p)[1] = (U8)((v) >> 8); \
+                                         (p)[2] = (U8)((v) >> 16); (p)[3] = (U8)((v) >> 24); } while(0)
+#else
+#define TONE_SELECT(list)
+#endif
+
+#ifdef __MMI_GAME_MULTICHANNEL_SOUND__
+#define GFX_TETRIS_AUDIO_ALLOWED()                                         \
+   (GFX.is_aud_on &&                                                       \
+      (srv_prof_is_profile_activated(SRV_PROF_SILENT_MODE) != SRV_PROF_RET_PROFILE_ACTIVATED) && !mmi_gfx_is_background_call())
 #else
-#define GFX_TETRIS_PLAY_AUDIO(raw_data, size, play_style)                  \
+#define GFX_TETRIS_AUDIO_ALLOWED()                                         \
+   ((srv_prof_is_profile_activated(SRV_PROF_SILENT_MODE) != SRV_PROF_RET_PROFILE_ACTIVATED) && !mmi_gfx_is_background_call())
+#endif
+
+#define GFX_TETRIS_PLAY_AUDIO(raw_data, size, format, play_style, handler, user_data, result) \
 do{                                                                        \
-   if((srv_prof_is_profile_activated(SRV_PROF_SILENT_MODE) != SRV_PROF_RET_PROFILE_ACTIVATED) && !mmi_gfx_is_background_call())           \
+   if(GFX_TETRIS_AUDIO_ALLOWED())                                          \
    {                                                                       \
-      mdi_audio_play_string_with_vol_path_non_block(  (void*)raw_data,     \
+      result = mdi_audio_play_string_with_vol_path_non_block(              \
+                                                      (void*)raw_data,     \
                                                       (U32)size,           \
-                                                      MDI_FORMAT_SMF,      \
+                                                      format,              \
                                                       play_style,          \
-                                                      NULL,                \
-                                                      NULL,                \
+                                                      handler,             \
+                                                      user_data,           \
                                                       GFX.aud_volume,      \
                                                       MDI_DEVICE_SPEAKER2);\
    }                                                                       \
 }while(0)
-#endif
 
 /*
 **----------------------------------------------------------------------------
@@ -169,8 +318,250 @@ typedef struct
     U16				gridRowMask;
     
     U8				keyBeepVolumeSetting;
+
+    U8				columnTop[MAX_COLUMN_NUMBER]; // topmost pinned row of every column
+    CGhost			theGhost;               // landing position of the falling tetris
+
+    TetRect			damagedArea;            // changed since the last present, dx == 0 if none
+
+    TetRect			coveredArea;            // where the pause or level prompt is drawn
+    gdi_image_cache_bmp_struct coveredAreaPixels; // what the prompt covers
+
+    U16				gameLines;              // rows deleted since the game started
+
+    U32				randomSeed;             // the game started from, 0 is taken as 1
+    U32				randomState;            // xorshift32 of the models, see generateRandomTetrisModel
+    U8				randomizer;             // RandomizerEnum
+    U8				bagCount;               // models left in the bag
+    U8				bag[MAX_BLOCK_KIND];    // dealt from the end
 } gx_tetris_context_struct;
 
+/* what an entry of the bundle costs, see loadBundleEntry */
+typedef struct
+{
+    const U8        *data;                  // BUNDLE_SPANS565 layout, NULL until used
+    U8              *decoded;               // RAM expansion of a BUNDLE_SPANS8 entry
+    U16             ramBytes;
+    U32             uses;
+    U32             firstUseUs;             // time of the first load, 0 if never used
+} CBundleCache;
+
+#ifdef __TETRIS_LATENCY_TRACE__
+/* key latency samples, see latencyKeyDown */
+typedef struct
+{
+    U8              depth;                  // nested key handlers
+    BOOL            pending;                // a key waits for its present
+    ActionTypeEnum  action;
+    U32             keyTime;                // drv_get_current_time() of the key
+    U32             count[ACTION_NUMBER];
+    U32             dropped[ACTION_NUMBER]; // keys which presented nothing
+    U32             maxUs[ACTION_NUMBER];
+    U16             histogram[ACTION_NUMBER][LATENCY_BUCKETS];
+} gx_tetris_latency_struct;
+#endif
+
+#ifdef __TETRIS_BENCHMARK__
+typedef enum
+{
+    BENCH_CAN_DO,                           // canDoAction, param is the action
+    BENCH_PIN,                              // pinTheFallingTetrisIf on the landing row
+    BENCH_DELETE,                           // deleteDirtyRowsIf, param is the full rows
+    BENCH_MOVE_DOWN,                        // moveDownwardsIf, one row
+    BENCH_MOVE_DOWN_FAST,                   // moveDownwardsIf, accelerated to the landing row
+    BENCH_LAUNCH,                           // launchOneTetris
+    BENCH_DRAW_TETRIS,                      // drawTetris of the falling tetris
+    BENCH_REDRAW,                           // redrawTheScreen
+    BENCH_REFRESH,                          // refreshPlayingZoneAfterDeleteDirtyRows, param is the full rows
+    BENCH_FLASH,                            // flashWhenDeleteDirtyRows, one flash
+    BENCH_SCORE,                            // drawGameScoreAndGameSpeed
+    BENCH_KIND_NUMBER
+} BenchKindEnum;
+
+/* one line of the suite, see benchmarkTheGameLogic */
+typedef struct
+{
+    const char      *name;
+    U8              kind;                   // BenchKindEnum
+    U8              param;
+    U8              height;                 // pinned rows under the falling tetris
+} CBenchCase;
+
+#endif
+
+#ifdef __TETRIS_RENDER_COUNT__
+/* what the draw paths did, see RENDER_COUNT */
+typedef struct
+{
+    U32             fills;
+    U32             blits;
+    U32             presents;
+    U32             pixels;                 // filled or copied
+    U32             presented;              // pixels blitted to the LCD
+    U32             frameStart;             // first draw since the last present, 0 if none
+    U32             frameTicks;             // from the first draw to the end of the present
+} CRenderCount;
+#endif
+
+#ifdef __TETRIS_MEM_ACCOUNT__
+/* a block handed out by TETRIS_ALLOC */
+typedef struct
+{
+    void            *p;                     // NULL if the entry is free
+    U32             size;
+    U16             line;                   // of the TETRIS_ALLOC
+} CMemoryBlock;
+
+/* a TETRIS_ALLOC line */
+typedef struct
+{
+    U16             line;                   // 0 if the entry is free
+    U16             blocks;                 // live now
+    U32             bytes;                  // live now
+    U32             peak;
+    U32             allocs;
+} CMemorySite;
+
+/* control buffer use of the game, see memoryAlloc */
+typedef struct
+{
+    U32             current;
+    U32             peak;
+    U32             failures;               // get_ctrl_buffer gave nothing
+    U32             badFrees;               // freed pointers which were not live
+    U16             untracked;              // live blocks which did not fit in block[]
+    CMemoryBlock    block[MEM_BLOCKS];
+    CMemorySite     site[MEM_SITES];
+} gx_tetris_memory_struct;
+#endif
+
+#ifdef __TETRIS_VIRTUAL_CLOCK__
+/* a timer of the virtual clock */
+typedef struct
+{
+    void            (*callback)( void);     // NULL if the entry is free
+    U32             due;                    // ms of the virtual clock
+} CVirtualTimer;
+
+/* the clock a harness drives the game timers with, see virtualFireTheNextTimer */
+typedef struct
+{
+    BOOL            on;                     // a harness drives the game, the MMI timers are left alone
+    U32             now;                    // virtual ms
+    U32             dropped;                // timers not armed, the table was full
+    CVirtualTimer   timer[VIRTUAL_TIMERS];
+} gx_tetris_clock_struct;
+
+/* what a harness puts back when it is done, see keepTheSession */
+typedef struct
+{
+    CPrefData       config;
+    U8              snapshot[TETRIS_SNAPSHOT_SIZE];
+    U16             snapshotSize;
+    U8              dirty;
+    U8              level;
+    U8              randomizer;
+    U32             seed;
+    BOOL            newGame;
+    BOOL            audio;
+} CTetrisSession;
+#endif
+
+#ifdef __TETRIS_REPLAY__
+/* the game being recorded or played back, see replayTheGame */
+typedef struct
+{
+    U8              depth;                  // nested key handlers, only timers outside of them tick
+    BOOL            playing;                // data drives the game, nothing is recorded
+    BOOL            full;                   // nothing more fits, the game is recorded no further
+    BOOL            keyframeDue;            // written at the next point between two events
+    U32             ticks;                  // game timer callbacks since the last record
+    U32             pieces;                 // launched since the game started
+    U32             keyframePiece;          // pieces at the last keyframe
+    U32             length;                 // of data
+    U8              data[REPLAY_SIZE];
+} gx_tetris_replay_struct;
+#endif
+
+#ifdef __TETRIS_GOLDEN__
+/* one present of the golden run, GOLDEN_FRAME_SIZE bytes in tetris_golden.gld */
+typedef struct
+{
+    U32             hash;                   // FNV-1a of the stand-in layer
+    U32             fills;                  // since the present before
+    U32             blits;
+    U32             pixels;
+    U32             presented;
+} CGoldenFrame;
+
+/* the golden frame run, see goldenTheGame */
+typedef struct
+{
+    BOOL            on;                     // the next replay is a golden run
+    BOOL            active;                 // the stand-in layer takes the drawing
+    BOOL            writing;                // there were no golden frames, they are written
+    BOOL            hud;                    // the overlay, off during the run
+    gdi_handle      layer;
+    FS_HANDLE       file;                   // tetris_golden.gld
+    U32             frames;                 // presented in this run
+    U32             stored;                 // golden frames compared
+    U32             differ;                 // frames whose hash is not the golden one
+    U32             first;                  // the first of them, from 1, 0 if none
+    CRenderCount    last;                   // the counters at the present before
+    CGoldenFrame    run;                    // totals, the hash is that of all the frames
+    CGoldenFrame    golden;                 // the same of the golden frames compared
+} gx_tetris_golden_struct;
+#endif
+
+#ifdef __TETRIS_SOAK__
+/* the soak run, see soakTheGame */
+typedef struct
+{
+    U32             random;                 // driver generator state, see soakRandom
+    U32             planned;                // tetris_pieces_launched when the last piece was placed
+    U32             cycles;
+    U32             games;
+    U32             levels;
+    U32             pauses;
+    U32             suspends;
+    U32             failures;
+    U32             inUse;                  // control buffer bytes after the last cycle
+} gx_tetris_soak_struct;
+#endif
+
+#ifdef __TETRIS_WATCHDOG__
+/* the callback being timed and what every kind took, see watchdogLeave */
+typedef struct
+{
+    U8              depth;                  // nested callbacks, 0 if none runs
+    U8              kind;                   // WatchdogKindEnum of the outermost one
+    U8              pathLength;
+    const char      *path[WATCHDOG_PATH];
+    U32             start;                  // drv_get_current_time() at the outermost entry
+    CRenderCount    counts;                 // the counters at the outermost entry
+    U32             calls[WATCHDOG_KIND_NUMBER];
+    U32             overruns[WATCHDOG_KIND_NUMBER];
+    U32             maxUs[WATCHDOG_KIND_NUMBER];
+    U16             histogram[WATCHDOG_KIND_NUMBER][WATCHDOG_BUCKETS];
+} gx_tetris_watchdog_struct;
+#endif
+
+#ifdef __TETRIS_PERF_HUD__
+/* the overlay and the game timers it follows, see hudUpdate */
+typedef struct
+{
+    BOOL            on;
+    S16             width;                  // of the box drawn last, 0 if none
+    S16             height;
+    CRenderCount    last;                   // the counters at the last update
+    void            (*timer[HUD_TIMERS])( void);
+    U32             due[HUD_TIMERS];        // drv_get_current_time() the timer is due at
+    U32             fired;                  // since the last update
+    U32             lateTicks;
+    U32             lateMax;
+} gx_tetris_hud_struct;
+#endif
+
 /*
 **----------------------------------------------------------------------------
 **  Global variables
@@ -191,7 +582,7 @@ gx_tetris_context_struct g_gx_tetris_context =
     
     GAME_STATE_INIT,
     GAME_STATE_INIT,
-    {0, FALSE, FALSE, {0,0,0}},
+    {0, FALSE, FALSE, {{{0}}}},
 	
 	0,
 	0,
@@ -233,15 +624,107 @@ gx_tetris_context_struct g_gx_tetris_context =
 	NULL,
 	0,
 
+	0,
+
+	{0},
+	{FALSE, FALSE, {0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, FALSE, {{0, 0}, {0, 0}, {0, 0}, {0, 0}}}},
+
+	{0,0,0,0},
+
+	{0,0,0,0},
+	{0, 0, NULL},
+
 	0
 };
 
 BOOL mmi_gx_tetris_showonce_timer_stop = FALSE; //improvisation for a show-once timer
 gx_tetris_context_struct* me;
-WCHAR drawee_string[128];
-BOOL tetris_ingame = FALSE; //do not free if not in gameover state
+WCHAR drawee_string[256];
+BOOL tetris_ingame = FALSE; //a game is in progress, suspended or not
+U8 tetris_snapshot[TETRIS_SNAPSHOT_SIZE]; //the suspended game, the board memory is freed
+U16 tetris_snapshot_size = 0; //0 if there is no suspended game
+U32 tetris_random_seed = 0; //of the next new game, 0 takes one from the clock
+U8 tetris_randomizer = TETRIS_RANDOMIZER; //RandomizerEnum of the next new game
+CBundleCache tetris_bundle_cache[TETRIS_ASSET_COUNT]; //the bundle entries in use
+MusicTypeEnum tetris_sound_pending = MUSIC_NUMBER; //the strongest request of this frame, see serviceTheAudio
+MusicTypeEnum tetris_sound_playing = MUSIC_NUMBER; //until its end callback comes
+U32 tetris_sound_start = 0; //drv_get_current_time() of the playing effect
+U32 tetris_sound_ticket = 0; //tells the end callback of the playing effect from older ones
+BOOL tetris_audio_armed = FALSE; //serviceTheAudio is due in this frame
+BOOL tetris_bgm_wanted = FALSE; //the loop should be heard, i.e. the game is running
+BgmStateEnum tetris_bgm_state = BGM_STOPPED;
+#ifdef __MMI_GAME_MULTICHANNEL_SOUND__
+mdi_handle tetris_bgm_handle = 0; //the loop is opened, thus parsed, once per game
+#endif
 BOOL tetris_nextlevel = FALSE;
-U8 dummy_gamelevel_val = 0;
+U8 dummy_gamelevel_val = 0; //level index the framework menu reads and writes
+BOOL tetris_config_loaded = FALSE; //configData holds the NVRAM settings of this session
+U8 tetris_config_dirty = 0; //CONFIG_DIRTY_* of configData, written when the game is idle
+
+/* a request never restarts the device while a stronger effect is playing */
+static const U8 tetris_sound_priority[MUSIC_NUMBER] =
+{
+    6,  // MUSIC_TITLE
+    1,  // MUSIC_PLACE
+    2,  // MUSIC_SINLINE
+    3,  // MUSIC_MULLINES
+    4,  // MUSIC_NEXTSPEED
+    5,  // MUSIC_NEXTLEVEL
+    6   // MUSIC_GAMEOVER
+};
+
+/* the framework menu still reads the level and the grades from these */
+static const U16 tetris_grade_nvram_id[MAX_LEVEL] =
+{
+    NVRAM_GX_TETRIS_SCORE_EASY,
+    NVRAM_GX_TETRIS_SCORE_MEDIUM,
+    NVRAM_GX_TETRIS_SCORE_HARD
+};
+#ifdef __TETRIS_LATENCY_TRACE__
+gx_tetris_latency_struct g_gx_tetris_latency;
+#endif
+#if TETRIS_TRACE_LEVEL > 0
+CTraceEvent tetris_trace_ring[TRACE_RING_SIZE]; //the last TRACE_RING_SIZE events
+U32 tetris_trace_head = 0; //events recorded, the next one goes to head % size
+#endif
+#ifdef __TETRIS_RENDER_COUNT__
+CRenderCount tetris_render_count; //since the start of the session
+#endif
+#ifdef __TETRIS_PERF_HUD__
+gx_tetris_hud_struct g_gx_tetris_hud;
+#endif
+#ifdef __TETRIS_WATCHDOG__
+gx_tetris_watchdog_struct g_gx_tetris_watchdog;
+#endif
+#ifdef __TETRIS_MEM_ACCOUNT__
+gx_tetris_memory_struct g_gx_tetris_memory;
+#endif
+#ifdef __TETRIS_VIRTUAL_CLOCK__
+gx_tetris_clock_struct g_gx_tetris_clock;
+BOOL tetris_headless = FALSE; //nothing is presented
+U32 tetris_pieces_launched = 0; //since the start of the session
+#endif
+#ifdef __TETRIS_SOAK__
+gx_tetris_soak_struct g_gx_tetris_soak;
+#endif
+#ifdef __TETRIS_REPLAY__
+gx_tetris_replay_struct g_gx_tetris_replay;
+#endif
+#ifdef __TETRIS_GOLDEN__
+gx_tetris_golden_struct g_gx_tetris_golden;
+#endif
+#ifdef __TETRIS_BENCHMARK__
+U32 tetris_bench_allocs = 0; //TETRIS_ALLOC calls so far
+U32 tetris_bench_random = 0; //fixture generator state, see benchRandom
+U8 tetris_bench_param = 0; //param of the case being timed
+char tetris_bench_json[BENCH_JSON_SIZE];
+BOOL tetris_bench_offscreen = FALSE; //drawing goes to a stand-in layer, nothing is presented
+#endif
+#ifdef __TETRIS_TONE_RENDERER__
+__align(4) U8 tetris_tone_ring[TONE_SLOTS][TONE_WAV_HEADER + TONE_SLOT_SAMPLES]; //rendered effects as WAV
+U8 tetris_tone_slot = 0; //the slot the last effect went to
+const CToneEvent *tetris_tone_owner[TONE_SLOTS]; //the note list each slot holds
+#endif
 /*
 **----------------------------------------------------------------------------
 **  Function(internal use only) Declarations
@@ -251,6 +734,10 @@ U8 dummy_gamelevel_val = 0;
 //==============================Init================================
 static boolean  initGameData( void);
 static void     freeGameDataMemory( void);
+static U16      encodeTheGameSnapshot( U8 *snapshot);
+static boolean  decodeTheGameSnapshot( U8 *snapshot, U16 size);
+static void     suspendTheGame( void);
+static boolean  resumeTheGame( void);
 static void     initParametersAccordingToScreenSize( void);
 //============================Processor=============================
 
@@ -259,11 +746,14 @@ static boolean  processKey( uint16 keyCode);
 static boolean  processCommand( uint16 commandId);
 
 static void     setGameState(GameStateEnum gameState);
+static boolean  theGameIsIdle( void);
+static void     startGameTimer( U16 elapse, void (*callback)(void));
 static void     gotoNextLevel( boolean bIsLastLevel);
 
 static void     startOneNewGame( void);
 static void     launchOneTetris( void);
 
+static void     seedTheRandomizer( U32 seed, RandomizerEnum randomizer);
 static uint8    generateRandomTetrisModel( void);
 static void     calculateAbsoluteCoordinates( CTetris* tetris, byte model, int16 xOrigin, int16 yOrigin);
 static void     drawGameScoreAndGameSpeed( void);
@@ -277,18 +767,94 @@ static boolean  pinTheFallingTetrisIf( void);
 static boolean  deleteDirtyRowsIf( void);
 static boolean  canDoAction( CTetris* tetris, ActionTypeEnum action);
 
+static boolean  calculateTheGhostTetris( void);
+static void     calculateTheColumnTops( void);
+
 static boolean  theGridIsDirtyOrInvalid( int16 x, int16 y);
 static boolean  theGridIsDirty( int16 x, int16 y);
 
 static void     saveGameDataAndDisplayGameScore( void);
 static void     saveSettingData( void);
+static S8       insertTheScore( int levelIndex, U32 score);
+static void     formatTheLeaderboard( int levelIndex, WCHAR *text, int size);
+static void     flushSettingData( void);
 static void     gameOver( void);
 
 static boolean  pauseOrResumeGame( void);
 
+#ifdef __TETRIS_TONE_RENDERER__
+static U32      renderTheTones( const CToneEvent *tones, U16 count, const U8 **wav);
+#endif
+
+#ifdef __TETRIS_BENCHMARK__
+static void     benchTheGame( void);
+#endif
+#if defined(__TETRIS_BENCHMARK__) || defined(__TETRIS_TRACE_EXPORT__) || defined(__TETRIS_REPLAY__)
+static FS_HANDLE openTheFile( const char *name, U32 flags);
+#endif
+#ifdef __TETRIS_TRACE_EXPORT__
+static void     traceExport( void);
+#endif
+#ifdef __TETRIS_MEM_ACCOUNT__
+static void     *memoryAlloc( U32 size, U16 line);
+static void     memoryFree( void *p, U16 line);
+static void     memoryReport( void);
+#endif
+#ifdef __TETRIS_VIRTUAL_CLOCK__
+static void     virtualStartTimer( U32 elapse, void (*callback)( void));
+static void     virtualCancelTimer( void (*callback)( void));
+#endif
+#ifdef __TETRIS_SOAK__
+static void     soakTheGame( void);
+#endif
+#ifdef __TETRIS_REPLAY__
+static void     replayStart( void);
+static void     replayKey( U8 code);
+static void     replayTick( void);
+static void     replayPiece( void);
+static void     replaySave( void);
+static void     replayTheFile( BOOL lastKeyframe, BOOL headless);
+#endif
+#ifdef __TETRIS_GOLDEN__
+static void     goldenBegin( void);
+static void     goldenFrame( void);
+static void     goldenEnd( void);
+static void     goldenTheGame( void);
+#endif
+#ifdef __TETRIS_WATCHDOG__
+static void     watchdogEnter( WatchdogKindEnum kind, const char *name);
+static void     watchdogStep( const char *name);
+static void     watchdogLeave( void);
+static void     watchdogReport( void);
+#endif
+#ifdef __TETRIS_PERF_HUD__
+static void     hudTimerArmed( void (*callback)( void), U16 elapse);
+static void     hudTimerFired( void (*callback)( void));
+static void     hudUpdate( void);
+static void     hudRepaintTheBox( void);
+#endif
+
+#ifdef __TETRIS_LATENCY_TRACE__
+static void     latencyKeyDown( ActionTypeEnum action);
+static void     latencyKeyDone( void);
+static void     latencyPresented( void);
+static void     latencyReport( void);
+#endif
+
 //-------------------- UI related method declaration
 static void     redrawTheScreen( void);
 
+static void     markTheDamagedArea( int16 x1, int16 y1, int16 x2, int16 y2);
+static void     fillRectangle( int16 x1, int16 y1, int16 x2, int16 y2, color fillColor);
+static void     showTransparentImage( int16 x, int16 y, PU8 image, color transparentColor);
+static const U8 *loadBundleEntry( U8 index);
+static void     releaseTheBundle( void);
+#ifdef __TETRIS_BUNDLE_REPORT__
+static void     bundleReport( void);
+#endif
+static void     drawBundleImage( U8 index, int16 x, int16 y);
+static void     presentTheScreen( void);
+
 static void     resetControlsAndClearScreen( boolean clearScreen);
 //static void     addMenuItem(IMenuCtl * pMenu, uint16 ItemID, uint16 ImageID);
 static void     drawPopWindowFrameBorder( uint16 titleID, TetRect * fRect);
@@ -308,18 +874,37 @@ static void     clearPlayingZoneAfterGameOver( void);
 static void     drawPlayingZoneBorder( void);
 static void     drawGridLines( void);
 static void     promptTheGameIsPausedNow( void);
+static boolean  saveTheCoveredArea( int16 x, int16 y, int16 dx, int16 dy);
+static boolean  restoreTheCoveredArea( void);
+static void     releaseTheCoveredArea( void);
+static void     promptTheLevelIsPassedNow( void);
+static void     continueAtTheNextLevel( void);
+static int16    drawWrappedText( TetRect *rect, UI_string_type text, boolean measureOnly);
+static void     drawGridCell( int16 x, int16 y, color cellColor);
+static void     restoreTheGridsUnderTheTetris( CTetris *tetris);
 static void     drawTetris( CTetris *tetris, boolean bOverDraw);
 static void     drawTheFallingTetris( void);
 static void     clearTheFallingTetris( void);
 static void     drawTheNextFallingTetris( void);
 static void     clearTheNextFallingTetris( void);
+static void     drawTheGhostTetris( void);
+static void     eraseTheGhostTetris( void);
+static color    getTheGhostColor( uint8 model);
 
 static void     refreshPlayingZoneAfterDeleteDirtyRows( void);
 static void     flashWhenDeleteDirtyRows( void);
 static void     drawTheFinalTetrisWhichFillupThePlayingZone( int16 YPos);
 static boolean  updateGameScoreAndGoToNextLevelIf( void);
+static void		loadSettingData(void);
+static boolean	loadLegacySettingData(void);
 static void		getSettingData(void);
 static boolean  playMusic( MusicTypeEnum type);
+static void     requestTheAudio( void);
+static void     serviceTheAudio( void);
+static void     flushTheSound( void);
+static void     soundFinished( mdi_result result, void *userData);
+static void     serviceTheBackgroundMusic( void);
+static void     stopTheAudio( void);
 
 /* Game framework related functions */
 S16 mmi_gx_tetris_calc_best_grade(S16 old_grade, S16 new_grade);      /* descide which is best grade */
@@ -335,15 +920,15 @@ void mmi_gx_tetris_cyclic_timer(void);
 void mmi_gx_tetris_init_game(void);   /* draw gameover screen */
 
 //=============================Init================================
-static boolean initGameDataMemory(void)
+static boolean initGameDataMemory( U16 screenWidth, U16 screenHeight)
 {
     int i           = 0;
 	
 	me = &g_gx_tetris_context;
 
-    g_gx_tetris_context.screenWidth  = UI_device_width;
-    g_gx_tetris_context.screenHeight =  UI_device_height;   // The width and height of the device.
-    debug( ";initApp, screen, cx = %d, cy = %d", UI_device_width, UI_device_height);
+    g_gx_tetris_context.screenWidth  = screenWidth;
+    g_gx_tetris_context.screenHeight = screenHeight;   // The width and height of the device.
+    debug( ";initApp, screen, cx = %d, cy = %d", screenWidth, screenHeight);
 
     g_gx_tetris_context.fontHeight = gui_get_character_height();
     debug( ";initApp, font height = %d", me->fontHeight);
@@ -351,7 +936,10 @@ static boolean initGameDataMemory(void)
     // calculate screen parameters according to the device infomation
     initParametersAccordingToScreenSize();
 
-    me->gridRowMap = get_ctrl_buffer( me->gridRowNumber * sizeof( uint16));
+    // what is not allocated stays NULL, freeGameDataMemory frees only the rest
+    me->gridRowMap = NULL;
+    me->gridMatrix = NULL;
+    me->gridRowMap = TETRIS_ALLOC( me->gridRowNumber * sizeof( uint16));
     if( me->gridRowMap == NULL)
     {
         debug( ";creating gridRowMap failed.");
@@ -368,17 +956,21 @@ static boolean initGameDataMemory(void)
     }
     debug( ";initApp, rows = %d, gridRowMask = 0x%x", me->gridRowNumber, me->gridRowMask);
 
-    me->gridMatrix = get_ctrl_buffer( me->gridRowNumber * sizeof( Grid*));
+    me->gridMatrix = TETRIS_ALLOC( me->gridRowNumber * sizeof( Grid*));
     if( me->gridMatrix == NULL)
     {
         debug( ";creating gridMatrix row dimension failed.");
         return FALSE;
     }
+    for( i = 0; i < me->gridRowNumber; i ++)
+    {
+        me->gridMatrix[i] = NULL;
+    }
 
     for( i = 0; i < me->gridRowNumber; i ++)
     {
 
-        me->gridMatrix[i] = get_ctrl_buffer( me->gridColumnNumber * sizeof(Grid));
+        me->gridMatrix[i] = TETRIS_ALLOC( me->gridColumnNumber * sizeof(Grid));
         if( me->gridMatrix[i] == NULL)
         {
             debug( "allocating memory for gridMatrix column %d dimension failed.", i);
@@ -415,6 +1007,7 @@ static boolean initGameData(void)
     me->flashCounterWhenDeleteDirtyRows = 0;
     me->dirtyRowNumber          = 0;
     me->gameScore                   = 0;
+    me->gameLines                   = 0;
 
     me->theTopmostRowOfThePinnedTetrises = me->gridRowNumber - 1;
     me->sleepTime   = ( MAX_LEVEL - me->gameLevel + 1) * INIT_TIME / MAX_LEVEL;
@@ -440,6 +1033,13 @@ static boolean initGameData(void)
         me->gridRowMap[i] = 0;
     }
 
+    for( j = 0; j < me->gridColumnNumber; j++)
+    {
+        me->columnTop[j] = (U8)me->gridRowNumber;
+    }
+    me->theGhost.valid = FALSE;
+    me->theGhost.drawn = FALSE;
+
 	return TRUE;
 }
 
@@ -447,94 +1047,489 @@ static void freeGameDataMemory(  void)
 {
     int i;
 
-    for( i = 0; i < me->gridRowNumber; i ++)
+    if( me == NULL)
+    {
+        return;
+    }
+
+    releaseTheCoveredArea();
+
+    // an allocation may have failed partway, see initGameDataMemory
+    if( me->gridMatrix != NULL)
+    {
+        for( i = 0; i < me->gridRowNumber && me->gridMatrix[i] != NULL; i ++)
+        {
+            TETRIS_FREE( me->gridMatrix[i]);
+        }
+        TETRIS_FREE( me->gridMatrix);
+        me->gridMatrix = NULL;
+    }
+    if( me->gridRowMap != NULL)
     {
-        free_ctrl_buffer( me->gridMatrix[i]);
+        TETRIS_FREE( me->gridRowMap);
+        me->gridRowMap = NULL;
     }
-    free_ctrl_buffer( me->gridMatrix);
-    free_ctrl_buffer( me->gridRowMap);
 	debug("data free");
 	me = NULL;
 }
 
-static void initParametersAccordingToScreenSize( void)
+/*
+** The snapshot is written in one pass and read in one pass:
+**
+**   version, rows, columns, gameState, gameLevel, flags
+**   gameScore, gameSpeed, sleepTime, gameLines           (U16, low byte first)
+**   theTopmostRowOfThePinnedTetrises
+**   model | axis << 4, pinned, 4 x (column, row)        the falling tetris
+**   model                                                the next falling tetris
+**   randomState                                          (U32, low byte first)
+**   randomizer | bagCount << 4, bagCount x model         the generator
+**   rows x gridRowMap                                    (U16, low byte first)
+**   3 bit tetris model of every pinned grid, row by row, left to right
+*/
+#define SNAPSHOT_PUT8( p, v)    ( *(p) ++ = (U8)(v))
+#define SNAPSHOT_PUT16( p, v)   ( SNAPSHOT_PUT8( p, (v) & 0xff), SNAPSHOT_PUT8( p, (v) >> 8))
+#define SNAPSHOT_GET8( p)       ( *(p) ++)
+#define SNAPSHOT_GET16( p)      ( (p) += 2, (U16)( (p)[-2] | ( (p)[-1] << 8)))
+#define SNAPSHOT_PUT32( p, v)   ( SNAPSHOT_PUT16( p, (v) & 0xffff), SNAPSHOT_PUT16( p, (v) >> 16))
+#define SNAPSHOT_GET32( p)      ( (p) += 4, (U32)(p)[-4] | ( (U32)(p)[-3] << 8) | ( (U32)(p)[-2] << 16) | ( (U32)(p)[-1] << 24))
+
+static U16 encodeTheGameSnapshot( U8 *snapshot)
 {
 
-    uint16 marginHorizontal = 0;
-    uint16 marginVertical   = 0;
+    U8      *p          = snapshot;
+    U32     bits        = 0;
+    int     bitCount    = 0;
+    int     i           = 0;
+    int     col         = 0;
 
-    // the playing zone has a fixed column number
-    me->gridColumnNumber    = 12;
+    // a cut short flash, the rows are deleted from the matrix already
+    if( me->dirtyRowNumber != 0)
+    {
+        me->theTopmostRowOfThePinnedTetrises += me->dirtyRowNumber;
+        me->flashCounterWhenDeleteDirtyRows = 0;
+        me->dirtyRowNumber = 0;
+    }
 
-    // determine grid size according to screen size,
-    // there are two borders, totally occupy 4 pixels
-    // and the next tetris occupies 4 grids
-    me->gridSideLength = ( me->screenWidth - 4) / ( me->gridColumnNumber + 4);
-    debug( ";init, grid, w / 16, %d", me->gridSideLength);
-    if( me->gridSideLength > 4)
+    SNAPSHOT_PUT8( p, TETRIS_SNAPSHOT_VERSION);
+    SNAPSHOT_PUT8( p, me->gridRowNumber);
+    SNAPSHOT_PUT8( p, me->gridColumnNumber);
+    SNAPSHOT_PUT8( p, me->gameState);
+    SNAPSHOT_PUT8( p, me->gameLevel);
+    SNAPSHOT_PUT8( p, tetris_nextlevel ? 1 : 0);
+    SNAPSHOT_PUT16( p, me->gameScore);
+    SNAPSHOT_PUT16( p, me->gameSpeed);
+    SNAPSHOT_PUT16( p, me->sleepTime);
+    SNAPSHOT_PUT16( p, me->gameLines);
+    SNAPSHOT_PUT8( p, me->theTopmostRowOfThePinnedTetrises);
+
+    SNAPSHOT_PUT8( p, me->theFallingTetris.model | ( me->theFallingTetris.axis << 4));
+    SNAPSHOT_PUT8( p, me->theFallingTetris.pinned);
+    for( i = 0; i < 4; i ++)
+    {
+        SNAPSHOT_PUT8( p, ( me->theFallingTetris.block[i].x - me->playingZone.x) / me->gridSideLength);
+        SNAPSHOT_PUT8( p, ( me->theFallingTetris.block[i].y - me->playingZone.y) / me->gridSideLength);
+    }
+    SNAPSHOT_PUT8( p, me->theNextFallingTetris.model);
+    SNAPSHOT_PUT32( p, me->randomState);
+    SNAPSHOT_PUT8( p, me->randomizer | ( me->bagCount << 4));
+    for( i = 0; i < me->bagCount; i ++)
     {
+        SNAPSHOT_PUT8( p, me->bag[i]);
+    }
 
-        if( ( (me->screenHeight - 4) / me->gridSideLength) < 16)
+    for( i = 0; i < me->gridRowNumber; i ++)
+    {
+        SNAPSHOT_PUT16( p, me->gridRowMap[i]);
+    }
+    for( i = 0; i < me->gridRowNumber; i ++)
+    {
+        for( col = 0; col < me->gridColumnNumber; col ++)
         {
-
-            me->gridSideLength = ( me->screenHeight - 4) / 16;
-            me->gridSideLength = me->gridSideLength < 4 ? 4: me->gridSideLength;
-            debug( ";init, grid, rows < 16, %d", me->gridSideLength);
+            if( me->gridMatrix[i][col].dirty)
+            {
+                bits |= ( me->gridMatrix[i][col].tetrisModel & 0x07) << bitCount;
+                bitCount += 3;
+                if( bitCount >= 8)
+                {
+                    SNAPSHOT_PUT8( p, bits & 0xff);
+                    bits >>= 8;
+                    bitCount -= 8;
+                }
+            }
         }
     }
+    if( bitCount > 0)
+    {
+        SNAPSHOT_PUT8( p, bits & 0xff);
+    }
 
-    // grid side is determined, now we determine grid row number
-    // it shall not more than 21
-    me->gridRowNumber = (me->screenHeight - 4) / me->gridSideLength;
-    me->gridRowNumber = me->gridRowNumber > 21 ? 21 : me->gridRowNumber;
-    debug( ";grid, rowNumber = %d, columnNumber = %d", me->gridRowNumber, me->gridColumnNumber);
-
-    // calculate the margin
-    marginHorizontal    = ( me->screenWidth - 4 - (me->gridSideLength * 17)) / 3;
-    marginVertical      = ( me->screenHeight - 4 -
-            me->gridRowNumber * me->gridSideLength) >> 1;
-
-    SETAEERECT( &me->playingZone,
-            marginHorizontal + 2,
-            marginVertical + 2,
-            me->gridSideLength * 12,
-            me->gridSideLength * me->gridRowNumber
-            );
-
-    me->xWhereToDrawTheNextFallingTetris = me->playingZone.x + me->playingZone.dx +
-                            marginHorizontal + ( me->gridSideLength << 1);
-    me->yWhereToDrawTheNextFallingTetris = me->gridSideLength;
-
-    me->yWhereToLaunchTetris = me->playingZone.y;
-    me->xWhereToLaunchTetris = me->playingZone.x +
-        (  (me->playingZone.dx - me->gridSideLength * (me->gridColumnNumber % 2)) >> 1);
-} // initParametersAccordingToScreenSize
-
-static void killTimer()
-{
-	gui_cancel_timer(moveDownwardsIf);
-	gui_cancel_timer(drawGameScoreAndGameSpeed);
-	gui_cancel_timer(flashWhenDeleteDirtyRows);
-	gui_cancel_timer(clearPlayingZoneAfterGameOver);
-	gui_cancel_timer(gameOver);
-}
-
-static void setGameState(GameStateEnum gameState)
-{
-	debug("state=====%d", gameState);
-    g_gx_tetris_context.previousGameState   = g_gx_tetris_context.gameState;
-    g_gx_tetris_context.gameState           = gameState;
-}
+    return (U16)( p - snapshot);
+} // encodeTheGameSnapshot
 
-static void startOneNewGame(  void)
+// Checks every value which indexes the board, the palette, the bag or a
+// leaderboard, or drives a loop or a timer, before the game takes any of
+// them, a keyframe of a replay comes from a file.
+static boolean theSnapshotIsSound( const U8 *snapshot, U16 size)
 {
 
-    resetControlsAndClearScreen(  TRUE);
-    initGameData();
-    drawPlayingZoneBorder();
-    drawGameScoreAndGameSpeed();
-
-    setGameState(GAME_STATE_RUNNING);
+    const U8    *p          = snapshot + 3;
+    const U8    *end        = snapshot + size;
+    U32         bits        = 0;
+    int         bitCount    = 0;
+    int         dirty       = 0;
+    int         i           = 0;
+    U16         rowMap      = 0;
+    U8          value       = 0;
+    U8          bagCount    = 0;
+
+    if( size < 31)
+    {
+        return FALSE;
+    }
+    value = SNAPSHOT_GET8( p);
+    if( value < GAME_STATE_RUNNING || value > GAME_STATE_REPORT)
+    {
+        return FALSE;
+    }
+    value = SNAPSHOT_GET8( p);
+    if( value < 1 || value > MAX_LEVEL)
+    {
+        return FALSE;
+    }
+    p += 1 + 2 + 2;                             // flags, score, speed
+    if( SNAPSHOT_GET16( p) == 0)                // sleepTime
+    {
+        return FALSE;
+    }
+    p += 2;                                     // lines
+    if( SNAPSHOT_GET8( p) > me->gridRowNumber)  // theTopmostRowOfThePinnedTetrises
+    {
+        return FALSE;
+    }
+    value = SNAPSHOT_GET8( p);
+    if( ( value & 0x0f) >= MAX_BLOCK_KIND || ( value >> 4) >= 4)
+    {
+        return FALSE;
+    }
+    p += 1;                                     // pinned
+    for( i = 0; i < 4; i ++)
+    {
+        if( SNAPSHOT_GET8( p) >= me->gridColumnNumber || SNAPSHOT_GET8( p) >= me->gridRowNumber)
+        {
+            return FALSE;
+        }
+    }
+    if( SNAPSHOT_GET8( p) >= MAX_BLOCK_KIND)
+    {
+        return FALSE;
+    }
+    p += 4;                                     // randomState
+    value    = SNAPSHOT_GET8( p);
+    bagCount = value >> 4;
+    if( ( value & 0x0f) > RANDOMIZER_BAG || bagCount > MAX_BLOCK_KIND ||
+        end - p < bagCount + me->gridRowNumber * 2)
+    {
+        return FALSE;
+    }
+    for( i = 0; i < bagCount; i ++)
+    {
+        if( SNAPSHOT_GET8( p) >= MAX_BLOCK_KIND)
+        {
+            return FALSE;
+        }
+    }
+    for( i = 0; i < me->gridRowNumber; i ++)
+    {
+        rowMap = SNAPSHOT_GET16( p);
+        if( ( rowMap & ~me->gridRowMask) != 0)
+        {
+            return FALSE; // theRowIsDirty would never see the row full
+        }
+        for( ; rowMap != 0; rowMap &= rowMap - 1)
+        {
+            dirty ++;
+        }
+    }
+    for( i = 0; i < dirty; i ++)
+    {
+        if( bitCount < 3)
+        {
+            if( p >= end)
+            {
+                return FALSE;
+            }
+            bits |= SNAPSHOT_GET8( p) << bitCount;
+            bitCount += 8;
+        }
+        if( ( bits & 0x07) >= MAX_BLOCK_KIND)
+        {
+            return FALSE;
+        }
+        bits >>= 3;
+        bitCount -= 3;
+    }
+    return TRUE;
+}
+
+// The board memory must be allocated for the same screen.
+static boolean decodeTheGameSnapshot( U8 *snapshot, U16 size)
+{
+
+    U8      *p          = snapshot;
+    U32     bits        = 0;
+    int     bitCount    = 0;
+    int     i           = 0;
+    int     col         = 0;
+    U8      value       = 0;
+
+    if( size < 24 + 5 || SNAPSHOT_GET8( p) != TETRIS_SNAPSHOT_VERSION ||
+        SNAPSHOT_GET8( p) != me->gridRowNumber || SNAPSHOT_GET8( p) != me->gridColumnNumber)
+    {
+        debug( ";snapshot does not fit this screen");
+        return FALSE;
+    }
+    if( !theSnapshotIsSound( snapshot, size))
+    {
+        debug( ";snapshot is damaged");
+        return FALSE;
+    }
+
+    me->gameState   = (GameStateEnum)SNAPSHOT_GET8( p);
+    me->gameLevel   = SNAPSHOT_GET8( p);
+    tetris_nextlevel = SNAPSHOT_GET8( p) & 1;
+    me->gameScore   = SNAPSHOT_GET16( p);
+    me->gameSpeed   = SNAPSHOT_GET16( p);
+    me->sleepTime   = SNAPSHOT_GET16( p);
+    me->gameLines   = SNAPSHOT_GET16( p);
+    me->theTopmostRowOfThePinnedTetrises = SNAPSHOT_GET8( p);
+
+    value = SNAPSHOT_GET8( p);
+    me->theFallingTetris.model  = value & 0x0f;
+    me->theFallingTetris.axis   = value >> 4;
+    me->theFallingTetris.pinned = SNAPSHOT_GET8( p);
+    for( i = 0; i < 4; i ++)
+    {
+        me->theFallingTetris.block[i].x = me->playingZone.x + SNAPSHOT_GET8( p) * me->gridSideLength;
+        me->theFallingTetris.block[i].y = me->playingZone.y + SNAPSHOT_GET8( p) * me->gridSideLength;
+    }
+    calculateAbsoluteCoordinates( &me->theNextFallingTetris,
+            SNAPSHOT_GET8( p),
+            me->xWhereToDrawTheNextFallingTetris,
+            me->yWhereToDrawTheNextFallingTetris);
+    me->randomState = SNAPSHOT_GET32( p);
+    value = SNAPSHOT_GET8( p);
+    me->randomizer  = value & 0x0f;
+    me->bagCount    = value >> 4;
+    for( i = 0; i < me->bagCount; i ++)
+    {
+        me->bag[i] = SNAPSHOT_GET8( p);
+    }
+
+    for( i = 0; i < me->gridRowNumber; i ++)
+    {
+        me->gridRowMap[i] = SNAPSHOT_GET16( p);
+        for( col = 0; col < me->gridColumnNumber; col ++)
+        {
+            Grid *grid = &me->gridMatrix[i][col];
+
+            grid->dirty = ( me->gridRowMap[i] >> ( me->gridColumnNumber - 1 - col)) & 1;
+            grid->tetrisModel = MAX_BLOCK_KIND;
+        }
+    }
+    for( i = 0; i < me->gridRowNumber; i ++)
+    {
+        for( col = 0; col < me->gridColumnNumber; col ++)
+        {
+            if( me->gridMatrix[i][col].dirty)
+            {
+                if( bitCount < 3)
+                {
+                    bits |= SNAPSHOT_GET8( p) << bitCount;
+                    bitCount += 8;
+                }
+                me->gridMatrix[i][col].tetrisModel = bits & 0x07;
+                bits >>= 3;
+                bitCount -= 3;
+            }
+        }
+    }
+
+    calculateTheColumnTops();
+    me->theGhost.valid  = FALSE;
+    me->theGhost.drawn  = FALSE;
+    me->flashCounterWhenDeleteDirtyRows = 0;
+    me->dirtyRowNumber  = 0;
+    me->moveDownwardAccelerated = FALSE;
+    return (U16)( p - snapshot) <= size;
+} // decodeTheGameSnapshot
+
+// Keeps the game in a few bytes and gives the board memory back.
+static void suspendTheGame( void)
+{
+
+    tetris_snapshot_size = encodeTheGameSnapshot( tetris_snapshot);
+    debug( ";suspended, snapshot %d bytes", tetris_snapshot_size);
+    freeGameDataMemory();
+}
+
+static boolean resumeTheGame( void)
+{
+
+    boolean resumed = FALSE;
+
+    if( tetris_snapshot_size == 0)
+    {
+        return FALSE;
+    }
+
+    if( initGameDataMemory( UI_device_width, UI_device_height))
+    {
+        resumed = decodeTheGameSnapshot( tetris_snapshot, tetris_snapshot_size);
+    }
+    tetris_snapshot_size = 0;
+
+    if( !resumed)
+    {
+        freeGameDataMemory();
+    }
+    return resumed;
+}
+
+static void initParametersAccordingToScreenSize( void)
+{
+
+    uint16 marginHorizontal = 0;
+    uint16 marginVertical   = 0;
+
+    // the playing zone has a fixed column number
+    me->gridColumnNumber    = 12;
+
+    // determine grid size according to screen size,
+    // there are two borders, totally occupy 4 pixels
+    // and the next tetris occupies 4 grids
+    me->gridSideLength = ( me->screenWidth - 4) / ( me->gridColumnNumber + 4);
+    debug( ";init, grid, w / 16, %d", me->gridSideLength);
+    if( me->gridSideLength > 4)
+    {
+
+        if( ( (me->screenHeight - 4) / me->gridSideLength) < 16)
+        {
+
+            me->gridSideLength = ( me->screenHeight - 4) / 16;
+            me->gridSideLength = me->gridSideLength < 4 ? 4: me->gridSideLength;
+            debug( ";init, grid, rows < 16, %d", me->gridSideLength);
+        }
+    }
+
+    // grid side is determined, now we determine grid row number
+    // it shall not more than 21
+    me->gridRowNumber = (me->screenHeight - 4) / me->gridSideLength;
+    me->gridRowNumber = me->gridRowNumber > MAX_ROW_NUMBER ? MAX_ROW_NUMBER : me->gridRowNumber;
+    debug( ";grid, rowNumber = %d, columnNumber = %d", me->gridRowNumber, me->gridColumnNumber);
+
+    // calculate the margin
+    marginHorizontal    = ( me->screenWidth - 4 - (me->gridSideLength * 17)) / 3;
+    marginVertical      = ( me->screenHeight - 4 -
+            me->gridRowNumber * me->gridSideLength) >> 1;
+
+    SETAEERECT( &me->playingZone,
+            marginHorizontal + 2,
+            marginVertical + 2,
+            me->gridSideLength * 12,
+            me->gridSideLength * me->gridRowNumber
+            );
+
+    me->xWhereToDrawTheNextFallingTetris = me->playingZone.x + me->playingZone.dx +
+                            marginHorizontal + ( me->gridSideLength << 1);
+    me->yWhereToDrawTheNextFallingTetris = me->gridSideLength;
+
+    me->yWhereToLaunchTetris = me->playingZone.y;
+    me->xWhereToLaunchTetris = me->playingZone.x +
+        (  (me->playingZone.dx - me->gridSideLength * (me->gridColumnNumber % 2)) >> 1);
+} // initParametersAccordingToScreenSize
+
+static void killTimer()
+{
+	gui_cancel_timer(moveDownwardsIf);
+	gui_cancel_timer(drawGameScoreAndGameSpeed);
+	gui_cancel_timer(flashWhenDeleteDirtyRows);
+	gui_cancel_timer(clearPlayingZoneAfterGameOver);
+	gui_cancel_timer(gameOver);
+}
+
+static void setGameState(GameStateEnum gameState)
+{
+	TRACE1( TRACE_STATE, gameState, g_gx_tetris_context.gameState);
+    g_gx_tetris_context.previousGameState   = g_gx_tetris_context.gameState;
+    g_gx_tetris_context.gameState           = gameState;
+
+    // the loop plays while the game runs, the audio service follows in the next frame
+    if( tetris_bgm_wanted != ( gameState == GAME_STATE_RUNNING))
+    {
+        tetris_bgm_wanted = ( gameState == GAME_STATE_RUNNING);
+        requestTheAudio();
+    }
+
+    // nothing ticks while the game waits for the user,
+    // a good moment to write what changed
+    if( theGameIsIdle())
+    {
+        killTimer();
+        if( tetris_config_dirty != 0)
+        {
+            gui_start_timer( SAVE_TIME, flushSettingData);
+        }
+    }
+}
+
+static boolean theGameIsIdle( void)
+{
+    switch( g_gx_tetris_context.gameState)
+    {
+        case GAME_STATE_MAIN_MENU:
+        case GAME_STATE_LEVEL_SETTING:
+        case GAME_STATE_SOUND_SETTING:
+        case GAME_STATE_GRID_SETTING:
+        case GAME_STATE_HERO:
+        case GAME_STATE_HELP:
+        case GAME_STATE_PAUSED:
+        case GAME_STATE_NEXTLEVEL:
+        case GAME_STATE_LASTLEVEL:
+        case GAME_STATE_REPORT:
+            return TRUE;
+
+        default:
+            return FALSE;
+    }
+}
+
+// All game timers are one-shot and armed for the next scheduled event only,
+// so there is no periodic tick to slow down, just nothing to arm when idle.
+static void startGameTimer( U16 elapse, void (*callback)(void))
+{
+    if( theGameIsIdle())
+    {
+        TRACE2( TRACE_TIMER_REFUSED, g_gx_tetris_context.gameState, elapse);
+        return;
+    }
+    HUD_TIMER_ARMED( callback, elapse);
+    gui_start_timer( elapse, callback);
+}
+
+static void startOneNewGame(  void)
+{
+
+    resetControlsAndClearScreen(  TRUE);
+    initGameData();
+    drawPlayingZoneBorder();
+    drawGameScoreAndGameSpeed();
+
+    setGameState(GAME_STATE_RUNNING);
+
+    seedTheRandomizer( tetris_random_seed != 0 ? tetris_random_seed : drv_get_current_time(),
+            (RandomizerEnum)tetris_randomizer);
+    debug( ";new game, seed = %u, randomizer = %d", me->randomSeed, me->randomizer);
+    REPLAY_START();
 
     me->theFallingTetris.pinned = FALSE;
     calculateAbsoluteCoordinates( &me->theNextFallingTetris,
@@ -542,7 +1537,7 @@ static void startOneNewGame(  void)
             me->xWhereToDrawTheNextFallingTetris,
             me->yWhereToDrawTheNextFallingTetris);
     launchOneTetris();
-	tetris_ingame = TRUE; //bypass value so as not to free data when next level screen shows up or resume game...
+	tetris_ingame = TRUE; //a game is in progress until its score is shown
 } // startOneNewGame
 
 static void launchOneTetris( void)
@@ -550,6 +1545,7 @@ static void launchOneTetris( void)
 
     uint8  i;
 
+    WATCHDOG_STEP( launchOneTetris);
     if( pinTheFallingTetrisIf())
     {
         if( deleteDirtyRowsIf() && !updateGameScoreAndGoToNextLevelIf())
@@ -570,12 +1566,14 @@ static void launchOneTetris( void)
             drawTheFinalTetrisWhichFillupThePlayingZone(me->theFallingTetris.block[i].y);
 
             playMusic(MUSIC_GAMEOVER);
-            gui_start_timer(OVER_TIME, gameOver);
+            startGameTimer(OVER_TIME, gameOver);
             return;
         }
     }
-    drawTheFallingTetris();
     me->theFallingTetris.pinned = FALSE;
+    TRACE1( TRACE_LAUNCH, me->theFallingTetris.model, me->theNextFallingTetris.model);
+    PIECE_LAUNCHED();
+    drawTheFallingTetris();
 
     clearTheNextFallingTetris();
     calculateAbsoluteCoordinates( &me->theNextFallingTetris,
@@ -585,12 +1583,74 @@ static void launchOneTetris( void)
     drawTheNextFallingTetris();
 
     me->moveDownwardAccelerated = FALSE;
-	gui_start_timer(me->sleepTime, moveDownwardsIf);
+	startGameTimer(me->sleepTime, moveDownwardsIf);
+    REPLAY_PIECE();
 } // launchOneTetris
 
+/*
+** The models come from a xorshift32 of the game state, not from rand(), so
+** a game is the same for the same seed and randomizer whatever else the
+** MMI draws, and it travels with the snapshot.
+*/
+static void seedTheRandomizer( U32 seed, RandomizerEnum randomizer)
+{
+    me->randomSeed  = seed;
+    me->randomState = seed != 0 ? seed : 1; // 0 would stay 0
+    me->randomizer  = randomizer;
+    me->bagCount    = 0;
+}
+
+static U32 nextRandom( void)
+{
+    U32 x = me->randomState;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return me->randomState = x;
+}
+
+// 0 .. range - 1, the values above the last whole multiple of range are
+// drawn again instead of folded onto the low ones
+static U32 randomBelow( U32 range)
+{
+    U32 limit = 0xffffffffU - 0xffffffffU % range;
+    U32 value;
+
+    do
+    {
+        value = nextRandom();
+    } while( value >= limit);
+    return value % range;
+}
+
 static uint8 generateRandomTetrisModel( void)
 {
-    return rand() % MAX_BLOCK_KIND;
+    int i, j;
+    U8  model;
+
+    if( me->randomizer != RANDOMIZER_BAG)
+    {
+        return (uint8)randomBelow( MAX_BLOCK_KIND);
+    }
+
+    // the next MAX_BLOCK_KIND models are filled in at once, shuffled
+    if( me->bagCount == 0)
+    {
+        for( i = 0; i < MAX_BLOCK_KIND; i ++)
+        {
+            me->bag[i] = i;
+        }
+        for( i = MAX_BLOCK_KIND - 1; i > 0; i --)
+        {
+            j = randomBelow( i + 1);
+            model      = me->bag[i];
+            me->bag[i] = me->bag[j];
+            me->bag[j] = model;
+        }
+        me->bagCount = MAX_BLOCK_KIND;
+    }
+    return me->bag[ -- me->bagCount];
 }
 
 static void calculateAbsoluteCoordinates(  CTetris* tetris,
@@ -705,7 +1765,7 @@ static boolean canDoAction( CTetris* tetris, ActionTypeEnum action)
                 )
                 {
 
-                    debug( ";rotate, grid[%d][%d] is dirty",
+                    TRACE2( TRACE_ROTATE_BLOCKED,
                             (x - me->playingZone.x) / me->gridSideLength,
                             (y - me->playingZone.y) / me->gridSideLength
                          );
@@ -733,7 +1793,7 @@ static boolean canDoAction( CTetris* tetris, ActionTypeEnum action)
                     yMin = y;
                 }
             }
-            debug( ";xMin: %d, xMax: %d, yMin: %d, yMax: %d", xMin, xMax, yMin, yMax);
+            TRACE2( TRACE_ROTATE_BOUNDS, xMin, yMin);
 
             // left blocked
             if( xMin < me->playingZone.x)
@@ -748,8 +1808,7 @@ static boolean canDoAction( CTetris* tetris, ActionTypeEnum action)
                         tetris->block[i].y + me->gridSideLength > me->playingZone.y + me->playingZone.dy
                     )
                     {
-                        debug( ";rotate, moveRight %d, grid[%d][%d] is dirty",
-                                distance,
+                        TRACE2( TRACE_KICK_RIGHT_BLOCKED,
                                 (tetris->block[i].x - me->playingZone.x) / me->gridSideLength,
                                 (tetris->block[i].y - me->playingZone.y) / me->gridSideLength
                              );
@@ -772,8 +1831,7 @@ static boolean canDoAction( CTetris* tetris, ActionTypeEnum action)
                         tetris->block[i].y + me->gridSideLength > me->playingZone.y + me->playingZone.dy
                     )
                     {
-                        debug( ";rotate, moveLeft %d, grid[%d][%d] is dirty",
-                                distance,
+                        TRACE2( TRACE_KICK_LEFT_BLOCKED,
                                 (tetris->block[i].x - me->playingZone.x) / me->gridSideLength,
                                 (tetris->block[i].y - me->playingZone.y) / me->gridSideLength
                              );
@@ -796,8 +1854,7 @@ static boolean canDoAction( CTetris* tetris, ActionTypeEnum action)
                         tetris->block[i].y + me->gridSideLength > me->playingZone.y + me->playingZone.dy
                     )
                     {
-                        debug( ";rotate, moveDown %d, grid[%d][%d] is dirty",
-                                distance,
+                        TRACE2( TRACE_KICK_DOWN_BLOCKED,
                                 (tetris->block[i].x - me->playingZone.x) / me->gridSideLength,
                                 (tetris->block[i].y - me->playingZone.y) / me->gridSideLength
                              );
@@ -825,31 +1882,32 @@ static boolean moveDownwardsIf( void)
     boolean returnValue = TRUE;
     CTetris tetris;
 
+    HUD_TIMER_FIRED( (void (*)( void))moveDownwardsIf);
+    REPLAY_TICK();
+    WATCHDOG_ENTER( WATCHDOG_GRAVITY, moveDownwardsIf);
     memcpy( &tetris, &me->theFallingTetris, sizeof( tetris));
-    clearTheFallingTetris();
 
     if( me->moveDownwardAccelerated)
     {
 
-        while( canDoAction( &tetris, ACTION_DOWN))
-        {
-            memcpy( &me->theFallingTetris, &tetris, sizeof( tetris));
-        }
-        me->theFallingTetris.pinned = TRUE;
+        // the ghost already knows where the tetris lands
+        calculateTheGhostTetris();
+        memcpy( &tetris, &me->theGhost.tetris, sizeof( tetris));
+        tetris.pinned = TRUE;
     }
-    else
+    else if( !canDoAction( &tetris, ACTION_DOWN))
     {
+        tetris.pinned = TRUE;
+    }
 
-        if( canDoAction( &tetris, ACTION_DOWN))
-        {
-            memcpy( &me->theFallingTetris, &tetris, sizeof( tetris));
-        }
-        else
-        {
-            me->theFallingTetris.pinned = TRUE;
-        }
+    // a blocked tetris is not repainted, so the tick presents nothing
+    if( memcmp( tetris.block, me->theFallingTetris.block, sizeof( tetris.block)) != 0)
+    {
+        clearTheFallingTetris();
+        memcpy( &me->theFallingTetris, &tetris, sizeof( tetris));
+        drawTheFallingTetris();
     }
-    drawTheFallingTetris();
+    me->theFallingTetris.pinned = tetris.pinned;
 
     if(me->theFallingTetris.pinned  || !canDoAction(&tetris, ACTION_DOWN) )
     {
@@ -860,9 +1918,10 @@ static boolean moveDownwardsIf( void)
         goto _moveDownwardIf_return_;
     }
 
-    gui_start_timer(me->sleepTime, moveDownwardsIf);
+    startGameTimer(me->sleepTime, moveDownwardsIf);
 
 _moveDownwardIf_return_:
+    WATCHDOG_LEAVE();
     return returnValue;
 } // moveDownwardsIf
 
@@ -919,7 +1978,15 @@ static boolean pinTheFallingTetrisIf( void)
             {
                 me->theTopmostRowOfThePinnedTetrises = row;
             }
+            if( row < me->columnTop[col])
+            {
+                me->columnTop[col] = (U8)row;
+            }
         }
+
+        // the ghost is covered by the pinned tetris now
+        me->theGhost.valid = FALSE;
+        me->theGhost.drawn = FALSE;
     } // if( pinned)
 
     return me->theFallingTetris.pinned;
@@ -959,7 +2026,99 @@ static boolean theGridIsDirty( int16 x, int16 y)
     }
 }
 
-static int getTheBottomMostYCoordinateOfTheFallingTetris( void)
+static void calculateTheColumnTops( void)
+{
+
+    int row = 0;
+    int col = 0;
+
+    for( col = 0; col < me->gridColumnNumber; col ++)
+    {
+        for( row = 0; row < me->gridRowNumber; row ++)
+        {
+            if( me->gridMatrix[row][col].dirty)
+            {
+                break;
+            }
+        }
+        me->columnTop[col] = (U8)row;
+    }
+}
+
+// Updates theGhost.tetris and returns TRUE if the landing position has to be
+// calculated again, i.e. the column span or the rotation of the falling tetris
+// or the height of the columns below it changed since the last call.
+static boolean calculateTheGhostTetris( void)
+{
+
+    CGhost  *ghost      = &me->theGhost;
+    CTetris *tetris     = &me->theFallingTetris;
+    int     i           = 0;
+    int     row         = 0;
+    int     col         = 0;
+    int     firstRow    = 0;
+    int     distance    = 0x7fff;
+    boolean overhang    = FALSE;
+    boolean keyMatched  = ghost->valid;
+
+    firstRow = ( tetris->block[0].y - me->playingZone.y) / me->gridSideLength;
+    for( i = 0; i < 4; i ++)
+    {
+        row = ( tetris->block[i].y - me->playingZone.y) / me->gridSideLength;
+        col = ( tetris->block[i].x - me->playingZone.x) / me->gridSideLength;
+
+        if( keyMatched &&
+            ( ghost->column[i] != col || ghost->rowOffset[i] != row - firstRow ||
+              ghost->columnTop[i] != me->columnTop[col])
+        )
+        {
+            keyMatched = FALSE;
+        }
+        ghost->column[i]    = (U8)col;
+        ghost->rowOffset[i] = (S8)( row - firstRow);
+        ghost->columnTop[i] = me->columnTop[col];
+
+        // the tetris is under a pinned one, the column top tells nothing
+        if( row >= me->columnTop[col])
+        {
+            overhang = TRUE;
+        }
+        else if( distance > me->columnTop[col] - 1 - row)
+        {
+            distance = me->columnTop[col] - 1 - row;
+        }
+    }
+
+    if( keyMatched)
+    {
+        return FALSE;
+    }
+
+    memcpy( &ghost->tetris, tetris, sizeof( CTetris));
+    if( overhang)
+    {
+        CTetris moved;
+
+        memcpy( &moved, tetris, sizeof( CTetris));
+        while( canDoAction( &moved, ACTION_DOWN))
+        {
+            memcpy( &ghost->tetris, &moved, sizeof( CTetris));
+        }
+    }
+    else
+    {
+        for( i = 0; i < 4; i ++)
+        {
+            ghost->tetris.block[i].y += distance * me->gridSideLength;
+        }
+    }
+
+    // below an overhang the landing row depends on the falling row as well
+    ghost->valid = !overhang;
+    return TRUE;
+} // calculateTheGhostTetris
+
+static int getTheBottomMostYCoordinateOfTheFallingTetris( void)
 {
 
     int i = 0;
@@ -990,6 +2149,7 @@ static boolean deleteDirtyRowsIf(  void)
     rect.dx = me->gridSideLength - 1;
     rect.dy = rect.dx;
 
+    WATCHDOG_STEP( deleteDirtyRowsIf);
     yOfTheFallingTetrisBottomMost = getTheBottomMostYCoordinateOfTheFallingTetris();
     row = ( yOfTheFallingTetrisBottomMost - me->playingZone.y) / me->gridSideLength;
     for( i = 0; row >= 0 && i < 4; i ++)
@@ -1019,6 +2179,9 @@ static boolean deleteDirtyRowsIf(  void)
     if( me->dirtyRowNumber != 0)
     {
 
+        TRACE1( TRACE_ROWS, me->dirtyRowNumber, me->theTopmostRowOfThePinnedTetrises);
+        calculateTheColumnTops();
+
         if( me->dirtyRowNumber == 1)
         {
             playMusic( MUSIC_SINLINE);
@@ -1067,314 +2230,2607 @@ static boolean pauseOrResumeGame( void)
 
         setGameState(GAME_STATE_RUNNING);
 
-        redrawTheScreen();
+        // the rest of the screen did not change while paused
+        if( !restoreTheCoveredArea())
+        {
+            redrawTheScreen();
+            return TRUE;
+        }
+        startGameTimer(me->sleepTime, moveDownwardsIf);
         return TRUE;
     }
 
     return FALSE;
 } // pauseOrResume
 
-//---------------------------- UI related method definition
-
-void Tetris_2Key(void)
+#ifdef __TETRIS_LATENCY_TRACE__
+// Only the outermost key handler is timed, a handler may call another one
+// on the way. A key which presents nothing is counted as dropped.
+static void latencyKeyDown( ActionTypeEnum action)
 {
- 	if(me->gameState == GAME_STATE_RUNNING && me->theFallingTetris.model != 6 &&
-       !me->theFallingTetris.pinned && me->flashCounterWhenDeleteDirtyRows == 0)
+    gx_tetris_latency_struct *lat = &g_gx_tetris_latency;
+
+    if( lat->depth ++ == 0)
     {
-		rotateIf();
+        lat->pending = TRUE;
+        lat->action  = action;
+        lat->keyTime = drv_get_current_time();
     }
 }
 
-void Tetris_4Key(void)
+static void latencyKeyDone( void)
 {
- 	if(me->gameState == GAME_STATE_RUNNING&&
-       !me->theFallingTetris.pinned && me->flashCounterWhenDeleteDirtyRows == 0)
+    gx_tetris_latency_struct *lat = &g_gx_tetris_latency;
+
+    if( -- lat->depth == 0 && lat->pending)
     {
-		moveLeftwardsIf();
+        lat->dropped[lat->action] ++;
+        lat->pending = FALSE;
     }
 }
 
-void Tetris_5Key(void)
+static void latencyPresented( void)
 {
-	 pauseOrResumeGame();
-}
+    gx_tetris_latency_struct *lat = &g_gx_tetris_latency;
+    U32 us;
+    U32 bucket;
 
-void Tetris_6Key(void)
-{
- 	if(me->gameState == GAME_STATE_RUNNING &&
-       !me->theFallingTetris.pinned && me->flashCounterWhenDeleteDirtyRows == 0)
+    if( !lat->pending)
     {
-		moveRightwardsIf();
+        return;
     }
-}
+    lat->pending = FALSE;
 
-void Tetris_8Key(void)
-{
- 	if(me->gameState == GAME_STATE_RUNNING &&
-       !me->theFallingTetris.pinned && me->flashCounterWhenDeleteDirtyRows == 0)
+    // 32K clock ticks to us
+    us = ( drv_get_current_time() - lat->keyTime) * 15625 / 512;
+    bucket = us / LATENCY_BUCKET_US;
+    bucket = bucket >= LATENCY_BUCKETS ? LATENCY_BUCKETS - 1 : bucket;
+
+    lat->count[lat->action] ++;
+    if( lat->histogram[lat->action][bucket] < 0xffff)
     {
-		gui_cancel_timer(moveDownwardsIf);
-        me->moveDownwardAccelerated = TRUE;
-        moveDownwardsIf();
+        lat->histogram[lat->action][bucket] ++;
+    }
+    if( lat->maxUs[lat->action] < us)
+    {
+        lat->maxUs[lat->action] = us;
     }
 }
 
-void Tetris_KeyboardKey(S32 vkey_code, S32 key_state)
+static U32 latencyPercentile( ActionTypeEnum action, U32 percent)
 {
-    /*----------------------------------------------------------------*/
-    /* Local Variables                                                */
-    /*----------------------------------------------------------------*/
+    gx_tetris_latency_struct *lat = &g_gx_tetris_latency;
+    U32 wanted  = ( lat->count[action] * percent + 99) / 100;
+    U32 seen    = 0;
+    int i;
 
-    /*----------------------------------------------------------------*/
-    /* Code Body                                                      */
-    /*----------------------------------------------------------------*/
-#if(MMI_BUILD_TYPE == BUILD_TYPE_X86WIN32)
-    if (key_state)
+    for( i = 0; i < LATENCY_BUCKETS - 1; i ++)
     {
-        switch (vkey_code)  /* key down */
+        seen += lat->histogram[action][i];
+        if( seen >= wanted)
         {
-            case 32:
-                Tetris_5Key();  /* left */
-                break;
-            case 37:
-                Tetris_4Key();  /* left */
-                break;
-            case 38:
-                Tetris_2Key();    /* up */
-                break;
-            case 39:
-                Tetris_6Key(); /* right */
-                break;
-            case 40:
-                Tetris_8Key();  /* down */
-                break;
-			case
-                //     case 1:         tetris_handle_key_exit();
-                //                             break;
+            return ( i + 1) * LATENCY_BUCKET_US;
         }
     }
-    else    /* key up */
+    return lat->maxUs[action];
+}
+
+static void latencyReport( void)
+{
+    static const char *names[ACTION_NUMBER] = { "none", "drop", "left", "right", "rotate", "pause"};
+    gx_tetris_latency_struct *lat = &g_gx_tetris_latency;
+    int i;
+
+    for( i = 0; i < ACTION_NUMBER; i ++)
     {
+        if( lat->count[i] == 0 && lat->dropped[i] == 0)
+        {
+            continue;
+        }
+        debug( ";latency %s, n = %d, dropped = %d, p50 <= %dus, p99 <= %dus, max = %dus",
+                names[i], lat->count[i], lat->dropped[i],
+                latencyPercentile( i, 50), latencyPercentile( i, 99), lat->maxUs[i]);
     }
-#else /* (MMI_BUILD_TYPE == BUILD_TYPE_X86WIN32) */ 
-    UI_UNUSED_PARAMETER(vkey_code);
-    UI_UNUSED_PARAMETER(key_state);
-#endif /* (MMI_BUILD_TYPE == BUILD_TYPE_X86WIN32) */ 
-
 }
+#endif /* __TETRIS_LATENCY_TRACE__ */
 
-static void displaySplashScreen(  void)
+#ifdef __TETRIS_MEM_ACCOUNT__
+/* The TETRIS_ALLOC line of a site entry, the last entry collects the lines beyond. */
+static CMemorySite *memorySite( U16 line)
 {
-	PU8				pImage = NULL;
-	gx_tetris_context_struct *me = &g_gx_tetris_context;
-	
-	pImage = (PU8)get_image(IMG_ID_GX_TETRIS_SPLASH);
+    gx_tetris_memory_struct *mem = &g_gx_tetris_memory;
+    int i;
 
-	if (pImage != NULL)
-	{
-		U32	iImgWdt,iImgHgt;
-		U32 iStrWdt,iStrHgt;
-		PU8 pTitleString;
-		TetRect rect;
-		gui_measure_image(pImage,&iImgWdt,&iImgHgt);
-		gui_set_clip(0, 0, UI_device_width - 1, UI_device_height - 1);
-		gui_fill_rectangle(0, 0, UI_device_width - 1, UI_device_height - 1, gui_color(0x0, 0xcf, 0xff));
-		gui_show_transparent_image((UI_device_width - iImgWdt)  >> 1,
-                       				UI_device_width - iImgHgt, pImage,0);
-		pTitleString = GetString(STR_GX_TETRIS_GAME_NAME);
-		gui_measure_string((UI_string_type)pTitleString, &iStrWdt, &iStrHgt);
-		rect.dx  = iStrWdt;
-        rect.x   = ( UI_device_width - rect.dx) >> 1;
-        rect.y   = ( UI_device_width - iImgHgt - iStrHgt) >> 1;
-        draw3DText( rect.x, rect.y, (UI_string_type)pTitleString);
-		gui_BLT_double_buffer(0, 0, UI_device_width - 1, UI_device_height - 1);
-		
-		playMusic(MUSIC_TITLE);
-	}
+    for( i = 0; i < MEM_SITES - 1; i ++)
+    {
+        if( mem->site[i].line == line || mem->site[i].line == 0)
+        {
+            mem->site[i].line = line;
+            return &mem->site[i];
+        }
+    }
+    return &mem->site[MEM_SITES - 1];
 }
 
-static void drawText3( S16 x, S16 y, UI_string_type text, RGBVAL color2draw, U32 flags)
+static void *memoryAlloc( U32 size, U16 line)
 {
-	color saved_color;
-	S32	str_wdt;
-	S32 str_hgt;
+    gx_tetris_memory_struct *mem = &g_gx_tetris_memory;
+    CMemorySite *site;
+    void *p;
+    int i;
 
-	saved_color = gui_get_text_color();
-	gui_set_text_color(gui_color(color2draw.r, color2draw.g, color2draw.b));
-	gui_measure_string(text, &str_wdt, &str_hgt);
+    p = get_ctrl_buffer( size);
+    if( p == NULL)
+    {
+        mem->failures ++;
+        debug( ";memory, %d bytes at line %d failed", size, line);
+        return NULL;
+    }
 
-    if (r2lMMIFlag)
+    for( i = 0; i < MEM_BLOCKS && mem->block[i].p != NULL; i ++)
+        ;
+    if( i < MEM_BLOCKS)
     {
-        gui_move_text_cursor(x + str_wdt, y);
+        mem->block[i].p    = p;
+        mem->block[i].size = size;
+        mem->block[i].line = line;
     }
     else
     {
-        gui_move_text_cursor(x, y);
+        mem->untracked ++;
     }
-	
-	gui_print_text(text);
-	gui_set_text_color(saved_color);
+
+    site = memorySite( line);
+    site->allocs ++;
+    site->blocks ++;
+    site->bytes += size;
+    site->peak   = site->bytes > site->peak ? site->bytes : site->peak;
+    mem->current += size;
+    mem->peak     = mem->current > mem->peak ? mem->current : mem->peak;
+    return p;
 }
 
-static void draw3DText( S16 x, S16 y, UI_string_type text)
+/* A pointer which is not live is reported and left alone, freeing it twice would break the pool. */
+static void memoryFree( void *p, U16 line)
 {
-	RGBVAL color1;
-	RGBVAL color2;
-	RGBVAL color3;
+    gx_tetris_memory_struct *mem = &g_gx_tetris_memory;
+    CMemorySite *site;
+    int i;
 
-	color1.r = color1.g = color1.b = 0xff;
-	color2.r = color2.g = color2.b = 0x00;
-	color3.r = 0xff;
-	color3.g = 0xcc;
-	color3.b = 0x00;
-	//drawText3( x, y - 1, text, color1, 0);
-	//drawText3( x - 1, y + 1, text, color2, 0);
-    //drawText3( x + 1, y + 1, text, color2, 0);
-    drawText3( x, y, text, color3, 0);
-}
+    for( i = 0; i < MEM_BLOCKS && mem->block[i].p != p; i ++)
+        ;
+    if( p == NULL || ( i == MEM_BLOCKS && mem->untracked == 0))
+    {
+        mem->badFrees ++;
+        debug( ";memory, free of 0x%x at line %d, not allocated or freed before", (U32)p, line);
+        return;
+    }
 
+    if( i == MEM_BLOCKS)
+    {
+        mem->untracked --;
+    }
+    else
+    {
+        site = memorySite( mem->block[i].line);
+        site->blocks --;
+        site->bytes  -= mem->block[i].size;
+        mem->current -= mem->block[i].size;
+        mem->block[i].p = NULL;
+    }
+    free_ctrl_buffer( p);
+}
 
-static void drawPlayingZoneBorder( void)
+/* After exit nothing should be live, a block still listed is a leak. */
+static void memoryReport( void)
 {
+    gx_tetris_memory_struct *mem = &g_gx_tetris_memory;
+    int i;
 
-    TetRect rect;
-
-    // to clear the screen with background color
-    rect.x  = 0;
-    rect.y  = 0;
-    rect.dx = me->screenWidth;
-    rect.dy = me->screenHeight;
-	gui_fill_rectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,COLOR_BACKGROUND);
+    debug( ";memory %dx%d, current = %d, peak = %d, failures = %d, bad frees = %d, untracked = %d",
+            UI_device_width, UI_device_height, mem->current, mem->peak,
+            mem->failures, mem->badFrees, mem->untracked);
+    for( i = 0; i < MEM_SITES; i ++)
+    {
+        if( mem->site[i].allocs != 0)
+        {
+            debug( ";memory line %d, allocs = %d, live = %d blocks %d bytes, peak = %d",
+                    mem->site[i].line, mem->site[i].allocs, mem->site[i].blocks,
+                    mem->site[i].bytes, mem->site[i].peak);
+        }
+    }
+    for( i = 0; i < MEM_BLOCKS; i ++)
+    {
+        if( mem->block[i].p != NULL)
+        {
+            debug( ";memory live, %d bytes from line %d", mem->block[i].size, mem->block[i].line);
+        }
+    }
+}
+#endif /* __TETRIS_MEM_ACCOUNT__ */
 
-    // to draw the border of the playing zone
-    // 1. draw inner border
-    rect.x  =  me->playingZone.x - 1;
-    rect.y  =  me->playingZone.y - 1;
-    rect.dx = me->playingZone.dx + 2;
-    rect.dy = me->playingZone.dy + 2;
-	gui_fill_rectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,gui_color(20,90,141));
-    // 2. draw outer border
-    rect.x  -=  1;
-    rect.y  -=  1;
-    rect.dx += 2;
-    rect.dy += 2;
-	gui_fill_rectangle(rect.x,rect.y,rect.x+rect.dx,rect.y+rect.dy-1,COLOR_BACKGROUND);
+#ifdef __TETRIS_WATCHDOG__
+/*
+** A game callback starts, a nested one only adds its name to the path so
+** the outermost callback is timed once with everything it called.
+*/
+static void watchdogEnter( WatchdogKindEnum kind, const char *name)
+{
+    gx_tetris_watchdog_struct *dog = &g_gx_tetris_watchdog;
 
-    // to draw grid lines
-    if( me->drawGridLines)
+    if( dog->depth ++ == 0)
     {
-        drawGridLines();
+        dog->kind       = kind;
+        dog->pathLength = 0;
+        dog->counts     = tetris_render_count;
+        dog->start      = drv_get_current_time();
     }
-
+    watchdogStep( name);
 }
 
-static void drawGridLines( void)
+static void watchdogStep( const char *name)
 {
+    gx_tetris_watchdog_struct *dog = &g_gx_tetris_watchdog;
 
-    int     i = 0;
-    int     x,y,ey;
-
-    x = me->playingZone.x - 1;
-    y = me->playingZone.y - 1;
-    ey = me->playingZone.y + me->playingZone.dy - 1;
-    for(i = 1; i < me->gridColumnNumber; i ++)
+    if( dog->depth != 0 && dog->pathLength < WATCHDOG_PATH)
     {
-        x += me->gridSideLength;
-		gui_fill_rectangle(x-1,y,x,ey,gui_color(0,0,0x8b));
+        dog->path[dog->pathLength ++] = name;
     }
-} // drawGridLines
+}
 
-static void promptTheGameIsPausedNow( void)
+/* The outermost callback ends, an overrun is logged with what it drew. */
+static void watchdogLeave( void)
 {
-
-    int16   x       = 0;
-    int16   y       = 0;
-    PU8		imagePaused = NULL;
-	U32	iImgWdt,iImgHgt;
-	
-	imagePaused = (PU8)get_image(IMG_ID_GX_TETRIS_GAMEPAUSE_EN);
-	if( imagePaused == NULL)
+    gx_tetris_watchdog_struct *dog = &g_gx_tetris_watchdog;
+    CRenderCount *now = &tetris_render_count;
+    char    path[WATCHDOG_PATH * 40];
+    U32     us;
+    U32     bucket;
+    int     i;
+
+    if( dog->depth == 0 || -- dog->depth != 0)
     {
         return;
     }
-	gui_measure_image(imagePaused,&iImgWdt,&iImgHgt);
-	
-    x = ( ( me->playingZone.dx - iImgWdt) >> 1) + me->playingZone.x;
-    y = ( ( me->playingZone.dy - iImgHgt) >> 1) + me->playingZone.y;
-	gui_show_transparent_image(x,y,imagePaused,0);
-	
-    gui_BLT_double_buffer(0, 0, UI_device_width - 1, UI_device_height - 1);
-} // promptTheGameIsPausedNow
 
-static void drawGameScoreAndGameSpeed( void)
-{
+    // 32K clock ticks to us
+    us = ( drv_get_current_time() - dog->start) * 15625 / 512;
+    for( bucket = 0; bucket < WATCHDOG_BUCKETS - 1 && us >= ( 1000U << bucket); bucket ++)
+        ;
 
-    uint16  x           = 0;
-    uint16  y           = 0;
-    uint16  digitWidth  = 0;
-    int8    i           = 0;
-    uint16  power       = 0;
-	PU8		imageScore = NULL;
-	PU8		imageSpeed = NULL;
-	PU8		imageDigit = NULL;
-	U32	iImgWdt,iImgHgt;
-	
-	imageScore = (PU8)get_image(IMG_ID_GX_TETRIS_GAMESCORE_EN);
-	if( imageScore == NULL)
+    dog->calls[dog->kind] ++;
+    if( dog->histogram[dog->kind][bucket] < 0xffff)
     {
-        return;
+        dog->histogram[dog->kind][bucket] ++;
     }
-	imageSpeed = (PU8)get_image(IMG_ID_GX_TETRIS_GAMESPEED_EN);
-	if( imageSpeed == NULL)
+    if( dog->maxUs[dog->kind] < us)
     {
-        return;
+        dog->maxUs[dog->kind] = us;
     }
-	
-    gui_measure_image(imageScore,&iImgWdt,&iImgHgt);
-    x = me->screenWidth - iImgWdt;
-    y = me->yWhereToDrawTheNextFallingTetris + 4 * me->gridSideLength;
-	gui_show_transparent_image(x,y,imageScore,0);
-	y += iImgHgt + 2;
-	
-    x = me->screenWidth;
-    for( i = 0, power = 1; i < 4; i ++, power *= 10)
+    if( us <= WATCHDOG_BUDGET_MS * 1000)
     {
-		imageDigit = (PU8)get_image(IMG_ID_GX_TETRIS_DIGIT_0+( me->gameScore / power % 10));
-		gui_measure_image(imageDigit,&iImgWdt,&iImgHgt);
-        x -= iImgWdt + 2;
-        gui_show_transparent_image(x,y,imageDigit,0);
+        return;
     }
 
-	gui_measure_image(imageSpeed,&iImgWdt,&iImgHgt);
-    x = me->screenWidth - iImgWdt;
-    y += iImgHgt + 6;
-	gui_show_transparent_image(x,y,imageSpeed,0);
-
-    y += iImgHgt + 2;
-    x = me->screenWidth;
-    for( i = 0, power = 1; i < 4; i ++, power *= 10)
+    dog->overruns[dog->kind] ++;
+    path[0] = '\0';
+    for( i = 0; i < dog->pathLength; i ++)
     {
-		imageDigit = (PU8)get_image(IMG_ID_GX_TETRIS_DIGIT_0+( me->gameSpeed / power % 10));
-		gui_measure_image(imageDigit,&iImgWdt,&iImgHgt);
-        x -= iImgWdt + 2;
-        gui_show_transparent_image(x,y,imageDigit,0);
+        strcat( path, i == 0 ? "" : ">");
+        strncat( path, dog->path[i], 38);
     }
-
-
+    debug( ";overrun %dus %s, fills = %d, blits = %d, presents = %d, pixels = %d",
+            us, path, now->fills - dog->counts.fills, now->blits - dog->counts.blits,
+            now->presents - dog->counts.presents, now->pixels - dog->counts.pixels);
 }
 
-static void redrawTheScreen( void)
+static void watchdogReport( void)
 {
-    int  i,j;
+    static const char *names[WATCHDOG_KIND_NUMBER] = { "gravity", "flash", "game over", "next level", "key"};
+    gx_tetris_watchdog_struct *dog = &g_gx_tetris_watchdog;
+    int i;
+
+    for( i = 0; i < WATCHDOG_KIND_NUMBER; i ++)
+    {
+        U16 *h = dog->histogram[i];
+
+        if( dog->calls[i] == 0)
+        {
+            continue;
+        }
+        debug( ";watchdog %s, n = %d, over %dms = %d, max = %dus, <1/2/4/8/16/32/64ms/more = %d/%d/%d/%d/%d/%d/%d/%d",
+                names[i], dog->calls[i], WATCHDOG_BUDGET_MS, dog->overruns[i], dog->maxUs[i],
+                h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7]);
+    }
+}
+#endif /* __TETRIS_WATCHDOG__ */
+
+#ifdef __TETRIS_BENCHMARK__
+/*
+** The suite runs the real code paths, drawing and timers included, on
+** boards built from a fixed seed. Each case and implementation runs in
+** batches for at least BENCH_MIN_TICKS; a case that changes the board
+** rebuilds it before every operation and the rebuild is timed alone and
+** taken off.
+**
+** A build can time a candidate against the current code in one run,
+** e.g. -DBENCH_B_canDoAction=canDoActionNew; the candidate has the same
+** signature and is reported as implementation "B" on the same boards.
+*/
+static boolean benchCanDoActionA( void)
+{
+    CTetris tetris = me->theFallingTetris;
+    return canDoAction( &tetris, (ActionTypeEnum)tetris_bench_param);
+}
+
+static boolean benchLaunchOneTetrisA( void)
+{
+    launchOneTetris();
+    return TRUE;
+}
+
+static boolean benchDrawTetris( void)
+{
+    drawTetris( &me->theFallingTetris, FALSE);
+    return TRUE;
+}
+
+static boolean benchRedrawTheScreen( void)
+{
+    redrawTheScreen();
+    return TRUE;
+}
+
+static boolean benchRefreshPlayingZone( void)
+{
+    refreshPlayingZoneAfterDeleteDirtyRows();
+    return TRUE;
+}
+
+static boolean benchFlashTheRows( void)
+{
+    flashWhenDeleteDirtyRows();
+    return TRUE;
+}
+
+static boolean benchDrawGameScore( void)
+{
+    drawGameScoreAndGameSpeed();
+    return TRUE;
+}
+
+#ifdef BENCH_B_canDoAction
+static boolean benchCanDoActionB( void)
+{
+    CTetris tetris = me->theFallingTetris;
+    return BENCH_B_canDoAction( &tetris, (ActionTypeEnum)tetris_bench_param);
+}
+#define BENCH_B_CAN_DO      benchCanDoActionB
+#else
+#define BENCH_B_CAN_DO      NULL
+#endif
+
+#ifdef BENCH_B_pinTheFallingTetrisIf
+#define BENCH_B_PIN         BENCH_B_pinTheFallingTetrisIf
+#else
+#define BENCH_B_PIN         NULL
+#endif
+
+#ifdef BENCH_B_deleteDirtyRowsIf
+#define BENCH_B_DELETE      BENCH_B_deleteDirtyRowsIf
+#else
+#define BENCH_B_DELETE      NULL
+#endif
+
+#ifdef BENCH_B_moveDownwardsIf
+#define BENCH_B_MOVE_DOWN   BENCH_B_moveDownwardsIf
+#else
+#define BENCH_B_MOVE_DOWN   NULL
+#endif
+
+#ifdef BENCH_B_launchOneTetris
+static boolean benchLaunchOneTetrisB( void)
+{
+    BENCH_B_launchOneTetris();
+    return TRUE;
+}
+#define BENCH_B_LAUNCH      benchLaunchOneTetrisB
+#else
+#define BENCH_B_LAUNCH      NULL
+#endif
+
+static boolean (* const tetris_bench_impl[BENCH_KIND_NUMBER][2])( void) =
+{
+    { benchCanDoActionA,        BENCH_B_CAN_DO},
+    { pinTheFallingTetrisIf,    BENCH_B_PIN},
+    { deleteDirtyRowsIf,        BENCH_B_DELETE},
+    { moveDownwardsIf,          BENCH_B_MOVE_DOWN},
+    { moveDownwardsIf,          BENCH_B_MOVE_DOWN},
+    { benchLaunchOneTetrisA,    BENCH_B_LAUNCH},
+    { benchDrawTetris,          NULL},
+    { benchRedrawTheScreen,     NULL},
+    { benchRefreshPlayingZone,  NULL},
+    { benchFlashTheRows,        NULL},
+    { benchDrawGameScore,       NULL}
+};
+
+static const CBenchCase tetris_bench_cases[] =
+{
+    { "canDoAction/none",           BENCH_CAN_DO,           ACTION_NONE,    8},
+    { "canDoAction/down",           BENCH_CAN_DO,           ACTION_DOWN,    8},
+    { "canDoAction/left",           BENCH_CAN_DO,           ACTION_LEFT,    8},
+    { "canDoAction/right",          BENCH_CAN_DO,           ACTION_RIGHT,   8},
+    { "canDoAction/rotate",         BENCH_CAN_DO,           ACTION_ROTATE,  8},
+    { "canDoAction/pause",          BENCH_CAN_DO,           ACTION_PAUSE,   8},
+    { "pinTheFallingTetrisIf/h0",   BENCH_PIN,              0,              0},
+    { "pinTheFallingTetrisIf/h8",   BENCH_PIN,              0,              8},
+    { "deleteDirtyRowsIf/1/h4",     BENCH_DELETE,           1,              4},
+    { "deleteDirtyRowsIf/2/h4",     BENCH_DELETE,           2,              4},
+    { "deleteDirtyRowsIf/3/h4",     BENCH_DELETE,           3,              4},
+    { "deleteDirtyRowsIf/4/h4",     BENCH_DELETE,           4,              4},
+    { "deleteDirtyRowsIf/1/h10",    BENCH_DELETE,           1,              10},
+    { "deleteDirtyRowsIf/2/h10",    BENCH_DELETE,           2,              10},
+    { "deleteDirtyRowsIf/3/h10",    BENCH_DELETE,           3,              10},
+    { "deleteDirtyRowsIf/4/h10",    BENCH_DELETE,           4,              10},
+    { "deleteDirtyRowsIf/1/h16",    BENCH_DELETE,           1,              16},
+    { "deleteDirtyRowsIf/2/h16",    BENCH_DELETE,           2,              16},
+    { "deleteDirtyRowsIf/3/h16",    BENCH_DELETE,           3,              16},
+    { "deleteDirtyRowsIf/4/h16",    BENCH_DELETE,           4,              16},
+    { "moveDownwardsIf/normal/h0",  BENCH_MOVE_DOWN,        0,              0},
+    { "moveDownwardsIf/normal/h8",  BENCH_MOVE_DOWN,        0,              8},
+    { "moveDownwardsIf/fast/h0",    BENCH_MOVE_DOWN_FAST,   0,              0},
+    { "moveDownwardsIf/fast/h8",    BENCH_MOVE_DOWN_FAST,   0,              8},
+    { "launchOneTetris/h8",         BENCH_LAUNCH,           0,              8}
+};
+
+#define BENCH_CASE_NUMBER   ( sizeof( tetris_bench_cases) / sizeof( tetris_bench_cases[0]))
+
+/* the draw paths, replayed on the same boards at every screen size */
+static const CBenchCase tetris_render_cases[] =
+{
+    { "drawTetris",                                 BENCH_DRAW_TETRIS,  0,  10},
+    { "redrawTheScreen/h10",                        BENCH_REDRAW,       0,  10},
+    { "refreshPlayingZoneAfterDeleteDirtyRows/4/h10", BENCH_REFRESH,    4,  10},
+    { "flashWhenDeleteDirtyRows/4/h10",             BENCH_FLASH,        4,  10},
+    { "drawGameScoreAndGameSpeed",                  BENCH_SCORE,        0,  10}
+};
+
+#define RENDER_CASE_NUMBER  ( sizeof( tetris_render_cases) / sizeof( tetris_render_cases[0]))
+
+/* the LCDs the game ships on, the ones the layer pool can't hold are skipped */
+static const U16 tetris_render_sizes[][2] =
+{
+    { 128, 128}, { 128, 160}, { 176, 220}, { 240, 320}, { 240, 400}, { 320, 480}
+};
+
+#define RENDER_SIZE_NUMBER  ( sizeof( tetris_render_sizes) / sizeof( tetris_render_sizes[0]))
+
+static U16 benchRandom( void)
+{
+    tetris_bench_random = tetris_bench_random * 1103515245 + 12345;
+    return ( U16)(( tetris_bench_random >> 16) & 0x7fff);
+}
+
+/* Builds the board of a case from the generator, the same for A and B. */
+static void benchBuildTheBoard( const CBenchCase *bench)
+{
+    int     height  = bench->height;
+    int     full    = ( bench->kind == BENCH_DELETE || bench->kind == BENCH_REFRESH ||
+                        bench->kind == BENCH_FLASH) ? bench->param : 0;
+    int     row, col, hole, bottom, i;
+    boolean dirty;
+
+    initGameData();
+    if( height > me->gridRowNumber - 4)
+    {
+        height = me->gridRowNumber - 4; // room for the falling tetris
+    }
+    for( row = me->gridRowNumber - height; row < me->gridRowNumber; row ++)
+    {
+        hole = benchRandom() % me->gridColumnNumber;
+        for( col = 0; col < me->gridColumnNumber; col ++)
+        {
+            dirty = row >= me->gridRowNumber - full || ( col != hole && benchRandom() % 4 != 0);
+            me->gridMatrix[row][col].dirty       = dirty;
+            me->gridMatrix[row][col].tetrisModel = dirty ? benchRandom() % MAX_BLOCK_KIND : MAX_BLOCK_KIND;
+            if( dirty)
+            {
+                me->gridRowMap[row] |= 1 << ( me->gridColumnNumber - 1 - col);
+            }
+        }
+    }
+    if( height > 0)
+    {
+        me->theTopmostRowOfThePinnedTetrises = me->gridRowNumber - height;
+    }
+    calculateTheColumnTops();
+    setGameState( GAME_STATE_RUNNING);
+    seedTheRandomizer( benchRandom(), TETRIS_RANDOMIZER);
+
+    calculateAbsoluteCoordinates( &me->theNextFallingTetris, benchRandom() % MAX_BLOCK_KIND,
+            me->xWhereToDrawTheNextFallingTetris, me->yWhereToDrawTheNextFallingTetris);
+    calculateAbsoluteCoordinates( &me->theFallingTetris, benchRandom() % MAX_BLOCK_KIND,
+            me->xWhereToLaunchTetris, me->yWhereToLaunchTetris);
+    me->theFallingTetris.pinned = FALSE;
+    me->moveDownwardAccelerated = bench->kind == BENCH_MOVE_DOWN_FAST;
+
+    switch( bench->kind)
+    {
+        case BENCH_PIN:
+            calculateTheGhostTetris();
+            me->theFallingTetris        = me->theGhost.tetris;
+            me->theFallingTetris.pinned = TRUE;
+            break;
+
+        case BENCH_DELETE:
+            // the rows are scanned upwards from the bottom of the tetris
+            bottom = getTheBottomMostYCoordinateOfTheFallingTetris();
+            for( i = 0; i < 4; i ++)
+            {
+                me->theFallingTetris.block[i].y += me->playingZone.y
+                    + ( me->gridRowNumber - 1) * me->gridSideLength - bottom;
+            }
+            me->theFallingTetris.pinned = TRUE;
+            break;
+
+        case BENCH_REFRESH:
+        case BENCH_FLASH:
+            // what deleteDirtyRowsIf leaves for the flash, the full rows from the bottom up
+            me->dirtyRowNumber = (U8)full;
+            for( i = 0; i < full; i ++)
+            {
+                me->dirtyRowIndex[i] = me->gridRowNumber - 1 - i;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* Times one implementation of a case, returns the ticks of count operations. */
+static U32 benchTimeTheCase( const CBenchCase *bench, U8 seedIndex,
+        boolean (*impl)( void), U32 *count, U32 *allocs, CRenderCount *drawn)
+{
+    boolean rebuild = bench->kind != BENCH_CAN_DO;
+    U32     start, ticks = 0, prepare = 0, n = 0, i;
+
+    tetris_bench_random = BENCH_SEED + seedIndex;
+    tetris_bench_param  = bench->param;
+    benchBuildTheBoard( bench);
+    *allocs = tetris_bench_allocs;
+    *drawn  = tetris_render_count; // building a board draws nothing
+    while( ticks < BENCH_MIN_TICKS)
+    {
+        start = drv_get_current_time();
+        for( i = 0; i < BENCH_BATCH; i ++)
+        {
+            if( rebuild)
+            {
+                benchBuildTheBoard( bench);
+            }
+            impl();
+        }
+        ticks += drv_get_current_time() - start;
+        n     += BENCH_BATCH;
+    }
+    killTimer();
+    drawn->fills    = tetris_render_count.fills    - drawn->fills;
+    drawn->blits    = tetris_render_count.blits    - drawn->blits;
+    drawn->presents = tetris_render_count.presents - drawn->presents;
+    drawn->pixels   = tetris_render_count.pixels   - drawn->pixels;
+
+    // the same boards once more without the operation
+    if( rebuild)
+    {
+        tetris_bench_random = BENCH_SEED + seedIndex;
+        benchBuildTheBoard( bench);
+        start = drv_get_current_time();
+        for( i = 0; i < n; i ++)
+        {
+            benchBuildTheBoard( bench);
+        }
+        prepare = drv_get_current_time() - start;
+    }
+
+    *count  = n;
+    *allocs = tetris_bench_allocs - *allocs;
+    return ticks > prepare ? ticks - prepare : 0;
+}
+
+/*
+** Replays the draw paths on a stand-in layer of the given size, the board
+** is allocated for that size. Returns the new length of the json.
+*/
+static int benchRenderAtSize( U16 width, U16 height, char *json, int length)
+{
+    const CBenchCase *bench;
+    CRenderCount drawn;
+    gdi_handle  layer;
+    U32         ticks, count, allocs;
+    U8          i;
+
+    length += sprintf( json + length, "%s{\"screen\":\"%dx%d\"",
+            width == tetris_render_sizes[0][0] && height == tetris_render_sizes[0][1] ? "" : ",",
+            width, height);
+
+    freeGameDataMemory();
+#ifdef __TETRIS_MEM_ACCOUNT__
+    g_gx_tetris_memory.peak = g_gx_tetris_memory.current;
+#endif
+    if( initGameDataMemory( width, height) == FALSE ||
+        gdi_layer_create( 0, 0, width, height, &layer) != GDI_LAYER_SUCCEED)
+    {
+        debug( ";bench %dx%d skipped", width, height);
+        return length + sprintf( json + length, ",\"skipped\":true}");
+    }
+    gdi_layer_push_and_set_active( layer);
+    gdi_layer_push_clip();
+    gdi_layer_set_clip( 0, 0, width - 1, height - 1);
+    tetris_bench_offscreen = TRUE;
+
+    length += sprintf( json + length, ",\"grid\":%d,\"rows\":%d,\"paths\":[",
+            me->gridSideLength, me->gridRowNumber);
+    for( i = 0; i < RENDER_CASE_NUMBER; i ++)
+    {
+        bench = &tetris_render_cases[i];
+        ticks = benchTimeTheCase( bench, i, tetris_bench_impl[bench->kind][0], &count, &allocs, &drawn);
+        debug( ";bench %dx%d %s, n = %d, ticks = %d, fills = %d, blits = %d, pixels = %d",
+                width, height, bench->name, count, ticks, drawn.fills, drawn.blits, drawn.pixels);
+        if( length + 192 < BENCH_JSON_SIZE)
+        {
+            length += sprintf( json + length,
+                    "%s{\"name\":\"%s\",\"frames\":%u,\"us_per_frame\":%.1f,\"fills\":%u,\"blits\":%u,\"presents\":%u,\"pixels\":%u}",
+                    i == 0 ? "" : ",", bench->name, count, ( double)ticks * 15625.0 / 512.0 / count,
+                    drawn.fills / count, drawn.blits / count, drawn.presents / count, drawn.pixels / count);
+        }
+    }
+
+    tetris_bench_offscreen = FALSE;
+    gdi_layer_pop_clip();
+    gdi_layer_pop_and_restore_active();
+    gdi_layer_free( layer);
+#ifdef __TETRIS_MEM_ACCOUNT__
+    // the board and what the draw paths took at this size
+    length += sprintf( json + length, "],\"peak_bytes\":%u}", g_gx_tetris_memory.peak);
+    debug( ";bench %dx%d, peak = %d bytes", width, height, g_gx_tetris_memory.peak);
+    return length;
+#else
+    return length + sprintf( json + length, "]}");
+#endif
+}
+
+/*
+** Runs the suite on the allocated board, sweeps the draw paths over the
+** screen sizes and writes tetris_bench.json.
+*/
+static void benchmarkTheGameLogic( void)
+{
+    const CBenchCase *bench;
+    CRenderCount drawn;
+    char    *json   = tetris_bench_json;
+    int     length  = 0;
+    U32     ticks, count, allocs;
+    U8      i, impl;
+    FS_HANDLE file;
+    UINT    written;
+
+    length += sprintf( json + length,
+            "{\"suite\":\"tetris-logic\",\"seed\":%d,\"rows\":%d,\"columns\":%d,\"results\":[",
+            BENCH_SEED, me->gridRowNumber, me->gridColumnNumber);
+    for( i = 0; i < BENCH_CASE_NUMBER; i ++)
+    {
+        bench = &tetris_bench_cases[i];
+        for( impl = 0; impl < 2; impl ++)
+        {
+            if( tetris_bench_impl[bench->kind][impl] == NULL)
+            {
+                continue;
+            }
+            ticks = benchTimeTheCase( bench, i, tetris_bench_impl[bench->kind][impl], &count, &allocs, &drawn);
+
+            // 32K ticks, 1953125 / 64 ns each
+            debug( ";bench %s %c, n = %d, ticks = %d, allocs = %d", bench->name, 'A' + impl, count, ticks, allocs);
+            if( length + 128 < BENCH_JSON_SIZE)
+            {
+                length += sprintf( json + length,
+                        "%s{\"name\":\"%s\",\"impl\":\"%c\",\"ops\":%u,\"ns_per_op\":%.1f,\"allocs_per_op\":%.3f}",
+                        ( i == 0 && impl == 0) ? "" : ",", bench->name, 'A' + impl, count,
+                        ( double)ticks * 1953125.0 / 64.0 / count, ( double)allocs / count);
+            }
+        }
+    }
+
+    length += sprintf( json + length, "],\"render\":[");
+    for( i = 0; i < RENDER_SIZE_NUMBER; i ++)
+    {
+        length = benchRenderAtSize( tetris_render_sizes[i][0], tetris_render_sizes[i][1], json, length);
+    }
+    length += sprintf( json + length, "]}\n");
+
+    // back to the board of this screen for the game
+    freeGameDataMemory();
+    initGameDataMemory( UI_device_width, UI_device_height);
+
+    stopTheAudio();
+    file = openTheFile( "tetris_bench.json", FS_CREATE_ALWAYS | FS_READ_WRITE);
+    if( file >= FS_NO_ERROR)
+    {
+        FS_Write( file, json, length, &written);
+        FS_Close( file);
+    }
+    debug( ";bench done, %d bytes of json", length);
+}
+
+/*
+** Leaves the game, runs the suite on a board of its own and enters again,
+** the game in progress is resumed from its snapshot. The suite blocks for
+** seconds, so it only runs when asked for.
+*/
+static void benchTheGame( void)
+{
+    U16     snapshotSize;
+    BOOL    newGame;
+
+    mmi_gx_tetris_exit_game();
+    snapshotSize = tetris_snapshot_size;
+    newGame      = g_gx_tetris_context.is_new_game;
+
+    mmi_gx_tetris_init_game();
+    if( me != NULL)
+    {
+        benchmarkTheGameLogic();
+    }
+    freeGameDataMemory();
+
+    tetris_snapshot_size = snapshotSize;
+    g_gx_tetris_context.is_new_game = newGame;
+    mmi_gx_tetris_enter_game();
+}
+#endif /* __TETRIS_BENCHMARK__ */
+
+#if defined(__TETRIS_BENCHMARK__) || defined(__TETRIS_TRACE_EXPORT__) || defined(__TETRIS_REPLAY__)
+/* Opens a file in the root of the normal drive, the handle is < 0 on failure. */
+static FS_HANDLE openTheFile( const char *name, U32 flags)
+{
+    WCHAR path[40];
+
+    kal_wsprintf( path, "%c:\\%s", FS_GetDrive( FS_DRIVE_V_NORMAL, 2, FS_DRIVE_V_REMOVABLE | FS_DRIVE_I_SYSTEM), name);
+    return FS_Open( path, flags);
+}
+#endif
+
+#ifdef __TETRIS_TRACE_EXPORT__
+/* Writes the ring as Chrome trace json, load it in chrome://tracing. */
+static void traceExport( void)
+{
+    static const char *names[TRACE_EVENT_NUMBER] =
+    {
+        "state", "launch", "rows", "sound play", "sound dropped", "key", "timer refused",
+        "rotate bounds", "rotate blocked", "kick right blocked", "kick left blocked",
+        "kick down blocked", "sound request", "present"
+    };
+    const CTraceEvent *record;
+    char        line[160];
+    U32         i, first;
+    UINT        written;
+    FS_HANDLE   file;
+
+    if( tetris_trace_head == 0 || ( file = openTheFile( "tetris_trace.json", FS_CREATE_ALWAYS | FS_READ_WRITE)) < FS_NO_ERROR)
+    {
+        return;
+    }
+    first = tetris_trace_head > TRACE_RING_SIZE ? tetris_trace_head - TRACE_RING_SIZE : 0;
+    FS_Write( file, "{\"traceEvents\":[\n", 17, &written);
+    for( i = first; i < tetris_trace_head; i ++)
+    {
+        record = &tetris_trace_ring[i & ( TRACE_RING_SIZE - 1)];
+        // 32K ticks to us, relative to the oldest record
+        sprintf( line, "%s{\"name\":\"%s\",\"cat\":\"tetris\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":1,"
+                "\"ts\":%.0f,\"args\":{\"a\":%d,\"b\":%d}}\n",
+                i == first ? "" : ",", record->event < TRACE_EVENT_NUMBER ? names[record->event] : "?",
+                ( double)( record->time - tetris_trace_ring[first & ( TRACE_RING_SIZE - 1)].time) * 15625.0 / 512.0,
+                record->a, record->b);
+        FS_Write( file, line, strlen( line), &written);
+    }
+    FS_Write( file, "]}\n", 3, &written);
+    FS_Close( file);
+}
+#endif /* __TETRIS_TRACE_EXPORT__ */
+
+#ifdef __TETRIS_PERF_HUD__
+/* Remembers when a game timer is due, a timer armed again moves its due time. */
+static void hudTimerArmed( void (*callback)( void), U16 elapse)
+{
+    gx_tetris_hud_struct *hud = &g_gx_tetris_hud;
+    int i, slot = -1;
+
+    for( i = 0; i < HUD_TIMERS; i ++)
+    {
+        if( hud->timer[i] == callback || ( slot < 0 && hud->timer[i] == NULL))
+        {
+            slot = i;
+            if( hud->timer[i] == callback)
+                break;
+        }
+    }
+    if( slot >= 0)
+    {
+        hud->timer[slot] = callback;
+        hud->due[slot]   = drv_get_current_time() + (U32)elapse * 32768 / 1000;
+    }
+}
+
+/* A timer callback runs, calls which were not armed as a timer are left out. */
+static void hudTimerFired( void (*callback)( void))
+{
+    gx_tetris_hud_struct *hud = &g_gx_tetris_hud;
+    S32 late;
+    int i;
+
+    for( i = 0; i < HUD_TIMERS; i ++)
+    {
+        if( hud->timer[i] != callback)
+            continue;
+
+        hud->timer[i] = NULL;
+        late = (S32)( drv_get_current_time() - hud->due[i]);
+        if( late >= 0)
+        {
+            hud->fired     ++;
+            hud->lateTicks += late;
+            if( (U32)late > hud->lateMax)
+                hud->lateMax = late;
+        }
+        return;
+    }
+}
+
+/*
+** Draws the last second in the top left corner and blits only that. The
+** overlay is drawn with gui_* directly, so it is not in the counters.
+*/
+static void hudUpdate( void)
+{
+    gx_tetris_hud_struct *hud   = &g_gx_tetris_hud;
+    CRenderCount        *now    = &tetris_render_count;
+    U32     frames      = now->presents  - hud->last.presents;
+    U32     pixels      = now->pixels    - hud->last.pixels;
+    U32     presented   = now->presented - hud->last.presented;
+    U32     overdraw    = presented ? pixels * 10 / presented : 0;
+    char    text[4][32];
+    WCHAR   line[32];
+    S32     width, height, boxWidth = 0;
+    color   savedColor;
+    int     i;
+
+    // 32K ticks, us = ticks * 15625 / 512
+    sprintf( text[0], "frame %dus x%d", frames ? ( now->frameTicks - hud->last.frameTicks) / frames * 15625 / 512 : 0, frames);
+    sprintf( text[1], "fill %d blit %d", now->fills - hud->last.fills, now->blits - hud->last.blits);
+    sprintf( text[2], "px %d od %d.%d", pixels, overdraw / 10, overdraw % 10);
+    sprintf( text[3], "late %d/%dms", hud->fired ? hud->lateTicks / hud->fired * 1000 / 32768 : 0, hud->lateMax * 1000 / 32768);
+
+    hud->last      = *now;
+    hud->fired     = 0;
+    hud->lateTicks = 0;
+    hud->lateMax   = 0;
+
+    savedColor = gui_get_text_color();
+    gui_measure_string( (UI_string_type)L"0", &width, &height);
+    for( i = 0; i < 4; i ++)
+    {
+        mmi_asc_to_ucs2( (CHAR*)line, text[i]);
+        gui_measure_string( line, &width, &height);
+        boxWidth = width > boxWidth ? width : boxWidth;
+    }
+    gui_fill_rectangle( 0, 0, boxWidth + 3, 4 * height + 3, gui_color( 0, 0, 0));
+    gui_set_text_color( gui_color( 255, 255, 0));
+    for( i = 0; i < 4; i ++)
+    {
+        mmi_asc_to_ucs2( (CHAR*)line, text[i]);
+        gui_move_text_cursor( 2, 2 + i * height);
+        gui_print_text( line);
+    }
+    gui_set_text_color( savedColor);
+    gui_BLT_double_buffer( 0, 0, boxWidth + 3, 4 * height + 3);
+    hud->width  = (S16)( boxWidth + 4);
+    hud->height = (S16)( 4 * height + 4);
+
+    gui_start_timer( HUD_PERIOD, hudUpdate);
+}
+
+/*
+** Paints the game again under the box, clipped to it. Nothing else is
+** touched, the step down and a running flash go on as they were.
+*/
+static void hudRepaintTheBox( void)
+{
+    gx_tetris_hud_struct *hud   = &g_gx_tetris_hud;
+    TetRect     damaged = g_gx_tetris_context.damagedArea;
+    CGhost      *ghost  = &me->theGhost;
+    int16       x, y;
+    uint8       tetrisModel;
+    int         i, j;
+
+    gui_set_clip( 0, 0, hud->width - 1, hud->height - 1);
+    drawPlayingZoneBorder();
+    drawGameScoreAndGameSpeed();
+    for( i = 0; i < me->gridRowNumber; i ++)
+    {
+        for( j = 0; j < me->gridColumnNumber; j ++)
+        {
+            x = j * me->gridSideLength + me->playingZone.x;
+            y = i * me->gridSideLength + me->playingZone.y;
+            if( me->gridMatrix[i][j].dirty && x < hud->width && y < hud->height)
+            {
+                tetrisModel = me->gridMatrix[i][j].tetrisModel;
+                drawGridCell( x, y, gui_color( COLOR_PALETTE[tetrisModel].r, COLOR_PALETTE[tetrisModel].g,
+                                               COLOR_PALETTE[tetrisModel].b));
+            }
+        }
+    }
+    for( i = 0; ghost->drawn && i < 4; i ++)
+    {
+        drawGridCell( ghost->tetris.block[i].x, ghost->tetris.block[i].y, getTheGhostColor( ghost->tetris.model));
+    }
+    drawTetris( &me->theFallingTetris, FALSE);
+    drawTetris( &me->theNextFallingTetris, FALSE);
+    if( me->gameState == GAME_STATE_PAUSED)
+    {
+        drawBundleImage( TETRIS_ASSET_GAMEPAUSE_EN,
+                ( ( me->playingZone.dx - tetris_bundle_index[TETRIS_ASSET_GAMEPAUSE_EN].width) >> 1) + me->playingZone.x,
+                ( ( me->playingZone.dy - tetris_bundle_index[TETRIS_ASSET_GAMEPAUSE_EN].height) >> 1) + me->playingZone.y);
+    }
+    gui_set_clip( 0, 0, UI_device_width - 1, UI_device_height - 1);
+
+    // the draws above marked more than they changed
+    g_gx_tetris_context.damagedArea = damaged;
+    markTheDamagedArea( 0, 0, hud->width - 1, hud->height - 1);
+    presentTheScreen();
+    hud->width = 0;
+}
+#endif /* __TETRIS_PERF_HUD__ */
+
+//---------------------------- UI related method definition
+
+void Tetris_2Key(void)
+{
+    LATENCY_KEY_DOWN( ACTION_ROTATE);
+    REPLAY_KEY( ACTION_ROTATE);
+    WATCHDOG_ENTER( WATCHDOG_KEY, Tetris_2Key);
+ 	if(me->gameState == GAME_STATE_RUNNING && me->theFallingTetris.model != 6 &&
+       !me->theFallingTetris.pinned && me->flashCounterWhenDeleteDirtyRows == 0)
+    {
+		rotateIf();
+    }
+    WATCHDOG_LEAVE();
+    REPLAY_KEY_DONE();
+    LATENCY_KEY_DONE();
+}
+
+void Tetris_4Key(void)
+{
+    LATENCY_KEY_DOWN( ACTION_LEFT);
+    REPLAY_KEY( ACTION_LEFT);
+    WATCHDOG_ENTER( WATCHDOG_KEY, Tetris_4Key);
+ 	if(me->gameState == GAME_STATE_RUNNING&&
+       !me->theFallingTetris.pinned && me->flashCounterWhenDeleteDirtyRows == 0)
+    {
+		moveLeftwardsIf();
+    }
+    WATCHDOG_LEAVE();
+    REPLAY_KEY_DONE();
+    LATENCY_KEY_DONE();
+}
+
+void Tetris_5Key(void)
+{
+    LATENCY_KEY_DOWN( ACTION_PAUSE);
+    REPLAY_KEY( ACTION_PAUSE);
+    WATCHDOG_ENTER( WATCHDOG_KEY, Tetris_5Key);
+	if (me->gameState == GAME_STATE_NEXTLEVEL)
+	{
+		continueAtTheNextLevel();
+	}
+	else
+	{
+		pauseOrResumeGame();
+	}
+    WATCHDOG_LEAVE();
+    REPLAY_KEY_DONE();
+    LATENCY_KEY_DONE();
+}
+
+void Tetris_6Key(void)
+{
+    LATENCY_KEY_DOWN( ACTION_RIGHT);
+    REPLAY_KEY( ACTION_RIGHT);
+    WATCHDOG_ENTER( WATCHDOG_KEY, Tetris_6Key);
+ 	if(me->gameState == GAME_STATE_RUNNING &&
+       !me->theFallingTetris.pinned && me->flashCounterWhenDeleteDirtyRows == 0)
+    {
+		moveRightwardsIf();
+    }
+    WATCHDOG_LEAVE();
+    REPLAY_KEY_DONE();
+    LATENCY_KEY_DONE();
+}
+
+void Tetris_8Key(void)
+{
+    LATENCY_KEY_DOWN( ACTION_DOWN);
+    REPLAY_KEY( ACTION_DOWN);
+    WATCHDOG_ENTER( WATCHDOG_KEY, Tetris_8Key);
+ 	if(me->gameState == GAME_STATE_RUNNING &&
+       !me->theFallingTetris.pinned && me->flashCounterWhenDeleteDirtyRows == 0)
+    {
+		gui_cancel_timer(moveDownwardsIf);
+        me->moveDownwardAccelerated = TRUE;
+        moveDownwardsIf();
+    }
+    WATCHDOG_LEAVE();
+    REPLAY_KEY_DONE();
+    LATENCY_KEY_DONE();
+}
+
+#ifdef __TETRIS_PERF_HUD__
+void Tetris_0Key(void)
+{
+    gx_tetris_hud_struct *hud = &g_gx_tetris_hud;
+
+    hud->on = !hud->on;
+    if( hud->on)
+    {
+        hud->last = tetris_render_count;
+        gui_start_timer( HUD_PERIOD, hudUpdate);
+    }
+    else
+    {
+        gui_cancel_timer( hudUpdate);
+        if( me == NULL || hud->width == 0)
+        {
+            return;
+        }
+        if( me->gameState == GAME_STATE_NEXTLEVEL || me->gameState == GAME_STATE_LASTLEVEL)
+        {
+            redrawTheScreen(); // the prompt is drawn again, no timer runs under it
+        }
+        else
+        {
+            hudRepaintTheBox();
+        }
+    }
+}
+#endif
+
+/* PC keyboard of the MoDIS build, it doubles as the interactive host frontend */
+void Tetris_KeyboardKey(S32 vkey_code, S32 key_state)
+{
+    /*----------------------------------------------------------------*/
+    /* Local Variables                                                */
+    /*----------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------*/
+    /* Code Body                                                      */
+    /*----------------------------------------------------------------*/
+#if(MMI_BUILD_TYPE == BUILD_TYPE_X86WIN32)
+    if (key_state)
+    {
+        switch (vkey_code)  /* key down */
+        {
+            case 32:
+                Tetris_5Key();  /* space */
+                break;
+            case 37:
+                Tetris_4Key();  /* left */
+                break;
+            case 38:
+                Tetris_2Key();    /* up */
+                break;
+            case 39:
+                Tetris_6Key(); /* right */
+                break;
+            case 40:
+                Tetris_8Key();  /* down */
+                break;
+        #ifdef __TETRIS_LATENCY_TRACE__
+            case 'L':
+                latencyReport();
+                break;
+        #endif
+        #ifdef __TETRIS_REPLAY__
+            case 'P':
+                replayTheFile( FALSE, FALSE);  /* from the start, drawn */
+                break;
+            case 'K':
+                replayTheFile( TRUE, TRUE);    /* from the last keyframe, headless */
+                break;
+        #endif
+        #ifdef __TETRIS_GOLDEN__
+            case 'G':
+                goldenTheGame();
+                break;
+        #endif
+        #ifdef __TETRIS_BENCHMARK__
+            case 'B':
+                benchTheGame();
+                break;
+        #endif
+        #ifdef __TETRIS_SOAK__
+            case 'S':
+                soakTheGame();
+                break;
+        #endif
+        #ifdef __TETRIS_MEM_ACCOUNT__
+            case 'M':
+                memoryReport();
+                break;
+        #endif
+        #ifdef __TETRIS_WATCHDOG__
+            case 'W':
+                watchdogReport();
+                break;
+        #endif
+        #ifdef __TETRIS_PERF_HUD__
+            case 'H':
+                Tetris_0Key();
+                break;
+        #endif
+                //     case 1:         tetris_handle_key_exit();
+                //                             break;
+        }
+    }
+    else    /* key up */
+    {
+    }
+#else /* (MMI_BUILD_TYPE == BUILD_TYPE_X86WIN32) */ 
+    UI_UNUSED_PARAMETER(vkey_code);
+    UI_UNUSED_PARAMETER(key_state);
+#endif /* (MMI_BUILD_TYPE == BUILD_TYPE_X86WIN32) */ 
+
+}
+
+#ifdef __TETRIS_VIRTUAL_CLOCK__
+/*
+** A harness drives the game on a virtual clock: the game timers are fired
+** in order of their due time as fast as the harness asks for them, so a run
+** does the same whatever the host does meanwhile.
+*/
+static void virtualStartTimer( U32 elapse, void (*callback)( void))
+{
+    gx_tetris_clock_struct *clock = &g_gx_tetris_clock;
+    int i, slot = -1;
+
+    if( !clock->on)
+    {
+        (gui_start_timer)( elapse, callback);
+        return;
+    }
+
+    // armed again, the timer moves like a MMI one
+    for( i = 0; i < VIRTUAL_TIMERS; i ++)
+    {
+        if( clock->timer[i].callback == callback || ( slot < 0 && clock->timer[i].callback == NULL))
+        {
+            slot = i;
+            if( clock->timer[i].callback == callback)
+                break;
+        }
+    }
+    if( slot < 0)
+    {
+        debug( ";virtual clock, more than %d timers pending", VIRTUAL_TIMERS);
+        clock->dropped ++; // the harness tells it as a failure
+        return;
+    }
+    clock->timer[slot].callback = callback;
+    clock->timer[slot].due      = clock->now + elapse;
+}
+
+static void virtualCancelTimer( void (*callback)( void))
+{
+    gx_tetris_clock_struct *clock = &g_gx_tetris_clock;
+    int i;
+
+    (gui_cancel_timer)( callback);
+    for( i = 0; i < VIRTUAL_TIMERS; i ++)
+    {
+        if( clock->timer[i].callback == callback)
+        {
+            clock->timer[i].callback = NULL;
+        }
+    }
+}
+
+/* Fires the timer due first, FALSE if none is pending. */
+static boolean virtualFireTheNextTimer( void)
+{
+    gx_tetris_clock_struct *clock = &g_gx_tetris_clock;
+    void (*callback)( void);
+    int i, next = -1;
+
+    for( i = 0; i < VIRTUAL_TIMERS; i ++)
+    {
+        if( clock->timer[i].callback != NULL &&
+            ( next < 0 || (S32)( clock->timer[i].due - clock->timer[next].due) < 0))
+        {
+            next = i;
+        }
+    }
+    if( next < 0)
+    {
+        return FALSE;
+    }
+    callback = clock->timer[next].callback;
+    clock->now = clock->timer[next].due;
+    clock->timer[next].callback = NULL;
+    callback();
+    return TRUE;
+}
+
+/* Takes the settings, the suspended game and what a new game starts from. */
+static void keepTheSession( CTetrisSession *session)
+{
+    memcpy( &session->config, &g_gx_tetris_context.configData, sizeof( session->config));
+    memcpy( session->snapshot, tetris_snapshot, sizeof( session->snapshot));
+    session->snapshotSize = tetris_snapshot_size;
+    session->newGame      = g_gx_tetris_context.is_new_game;
+    session->dirty        = tetris_config_dirty;
+    session->level        = dummy_gamelevel_val;
+    session->audio        = GFX.is_aud_on;
+    session->seed         = tetris_random_seed;
+    session->randomizer   = tetris_randomizer;
+}
+
+static void restoreTheSession( const CTetrisSession *session)
+{
+    memcpy( &g_gx_tetris_context.configData, &session->config, sizeof( session->config));
+    memcpy( tetris_snapshot, session->snapshot, sizeof( session->snapshot));
+    tetris_snapshot_size = session->snapshotSize;
+    g_gx_tetris_context.is_new_game = session->newGame;
+    tetris_config_dirty = session->dirty;
+    dummy_gamelevel_val = session->level;
+    GFX.is_aud_on       = session->audio;
+    tetris_random_seed  = session->seed;
+    tetris_randomizer   = session->randomizer;
+}
+#endif /* __TETRIS_VIRTUAL_CLOCK__ */
+
+#ifdef __TETRIS_REPLAY__
+/*
+** A replay is the seed of a game and what the player did, tetris_replay.trp:
+**
+**   'T', 'R', 'P', REPLAY_VERSION, TETRIS_SNAPSHOT_VERSION
+**   randomSeed                                 (U32, low byte first)
+**   randomizer, gameLevel, rows, columns
+**   records, each one a varint of ticks << 3 | code, then
+**     code ACTION_DOWN .. ACTION_PAUSE         nothing, the key
+**     code REPLAY_CONTINUE                     nothing, the level prompt soft key
+**     code REPLAY_KEYFRAME                     varint pieces, state hash (U32),
+**                                              varint size, the suspend snapshot
+**
+** A varint keeps 7 bits a byte, low bits first, the top bit set if more
+** follow. Ticks are the game timer callbacks since the record before, not
+** milliseconds: played back on the virtual clock, the same callbacks run
+** between the same keys whatever the timing was.
+**
+** A keyframe is due every REPLAY_KEYFRAME_PIECES pieces and written at the
+** next point between two events when the game runs and no rows flash, so
+** the only game timer pending is the next step down. The player can start
+** from any keyframe and checks every one it passes.
+*/
+#define REPLAY_HEADER_SIZE  13
+
+static void replayPut( U8 value)
+{
+    gx_tetris_replay_struct *replay = &g_gx_tetris_replay;
+
+    if( replay->length < REPLAY_SIZE)
+    {
+        replay->data[replay->length ++] = value;
+    }
+}
+
+static void replayPutVar( U32 value)
+{
+    while( value >= 0x80)
+    {
+        replayPut( (U8)( value | 0x80));
+        value >>= 7;
+    }
+    replayPut( (U8)value);
+}
+
+static void replayPut32( U32 value)
+{
+    replayPut( (U8)value);
+    replayPut( (U8)( value >> 8));
+    replayPut( (U8)( value >> 16));
+    replayPut( (U8)( value >> 24));
+}
+
+static BOOL replayGetVar( const U8 **p, const U8 *end, U32 *value)
+{
+    int shift = 0;
+
+    *value = 0;
+    while( *p < end && shift < 32)
+    {
+        *value |= (U32)( **p & 0x7f) << shift;
+        if( ( *( *p) ++ & 0x80) == 0)
+        {
+            return TRUE;
+        }
+        shift += 7;
+    }
+    return FALSE;
+}
+
+static U32 replayGet32( const U8 *p)
+{
+    return (U32)p[0] | ( (U32)p[1] << 8) | ( (U32)p[2] << 16) | ( (U32)p[3] << 24);
+}
+
+/* FNV-1a of the snapshot and what is derived from it. */
+static U32 replayHashTheState( const U8 *snapshot, U16 size)
+{
+    U32 hash = 2166136261U;
+    int i;
+
+    for( i = 0; i < size; i ++)
+    {
+        hash = ( hash ^ snapshot[i]) * 16777619U;
+    }
+    for( i = 0; i < me->gridColumnNumber; i ++)
+    {
+        hash = ( hash ^ me->columnTop[i]) * 16777619U;
+    }
+    return hash;
+}
+
+/* Between two events with only the next step down pending, see the format. */
+static BOOL replayCanTakeAKeyframe( void)
+{
+    return me != NULL && me->gameState == GAME_STATE_RUNNING &&
+           me->flashCounterWhenDeleteDirtyRows == 0 && me->dirtyRowNumber == 0;
+}
+
+static void replayKeyframe( void)
+{
+    gx_tetris_replay_struct *replay = &g_gx_tetris_replay;
+    U8  snapshot[TETRIS_SNAPSHOT_SIZE];
+    U16 size;
+
+    size = encodeTheGameSnapshot( snapshot);
+    if( replay->length + 5 + 5 + 4 + 5 + size > REPLAY_SIZE)
+    {
+        replay->full = TRUE;
+        return;
+    }
+    replayPutVar( replay->ticks << 3 | REPLAY_KEYFRAME);
+    replayPutVar( replay->pieces);
+    replayPut32( replayHashTheState( snapshot, size));
+    replayPutVar( size);
+    memcpy( replay->data + replay->length, snapshot, size);
+    replay->length       += size;
+    replay->ticks         = 0;
+    replay->keyframePiece = replay->pieces;
+    replay->keyframeDue   = FALSE;
+}
+
+/* What the player does, the keyframe comes first if it is due. */
+static void replayRecord( U8 code)
+{
+    gx_tetris_replay_struct *replay = &g_gx_tetris_replay;
+
+    if( replay->playing || replay->full)
+    {
+        return;
+    }
+    if( replay->keyframeDue && replayCanTakeAKeyframe())
+    {
+        replayKeyframe();
+    }
+    if( replay->length + 5 > REPLAY_SIZE)
+    {
+        replay->full = TRUE;
+        return;
+    }
+    replayPutVar( replay->ticks << 3 | code);
+    replay->ticks = 0;
+}
+
+/* A new game, the recording starts over unless a replay plays. */
+static void replayStart( void)
+{
+    gx_tetris_replay_struct *replay = &g_gx_tetris_replay;
+
+    replay->depth         = 0;
+    replay->ticks         = 0;
+    replay->pieces        = 0;
+    replay->keyframePiece = 0;
+    replay->keyframeDue   = FALSE;
+    if( replay->playing)
+    {
+        return;
+    }
+
+    replay->full   = FALSE;
+    replay->length = 0;
+    replayPut( 'T');
+    replayPut( 'R');
+    replayPut( 'P');
+    replayPut( REPLAY_VERSION);
+    replayPut( TETRIS_SNAPSHOT_VERSION);
+    replayPut32( me->randomSeed);
+    replayPut( me->randomizer);
+    replayPut( me->gameLevel);
+    replayPut( (U8)me->gridRowNumber);
+    replayPut( (U8)me->gridColumnNumber);
+}
+
+static void replayKey( U8 code)
+{
+    if( g_gx_tetris_replay.depth ++ == 0)
+    {
+        replayRecord( code);
+    }
+}
+
+/* A game timer callback starts, not one called from a key handler. */
+static void replayTick( void)
+{
+    gx_tetris_replay_struct *replay = &g_gx_tetris_replay;
+
+    if( replay->depth != 0)
+    {
+        return;
+    }
+    if( replay->keyframeDue && !replay->playing && !replay->full && replayCanTakeAKeyframe())
+    {
+        replayKeyframe();
+    }
+    replay->ticks ++;
+}
+
+static void replayPiece( void)
+{
+    gx_tetris_replay_struct *replay = &g_gx_tetris_replay;
+
+    replay->pieces ++;
+    if( replay->pieces - replay->keyframePiece >= REPLAY_KEYFRAME_PIECES)
+    {
+        replay->keyframeDue = TRUE;
+    }
+}
+
+/* Ends the recording with a keyframe and writes it, it goes on if the game does. */
+static void replaySave( void)
+{
+    gx_tetris_replay_struct *replay = &g_gx_tetris_replay;
+    FS_HANDLE   file;
+    UINT        written;
+
+    if( replay->playing || replay->length <= REPLAY_HEADER_SIZE)
+    {
+        return;
+    }
+    if( !replay->full && replay->keyframePiece != replay->pieces && replayCanTakeAKeyframe())
+    {
+        replayKeyframe();
+    }
+    if( ( file = openTheFile( "tetris_replay.trp", FS_CREATE_ALWAYS | FS_READ_WRITE)) < FS_NO_ERROR)
+    {
+        return;
+    }
+    FS_Write( file, replay->data, replay->length, &written);
+    FS_Close( file);
+    debug( ";replay, %d pieces in %d bytes%s", replay->pieces, replay->length, replay->full ? ", cut short" : "");
+}
+
+/* Forgets the replay in data, the recording starts again with the next new game. */
+static void replayDrop( void)
+{
+    g_gx_tetris_replay.playing  = FALSE;
+    g_gx_tetris_replay.length   = 0;
+    g_gx_tetris_replay.full     = TRUE;
+}
+
+/* Fires the game timers until the record is due, FALSE if the game stopped before. */
+static BOOL replayWaitFor( U32 ticks)
+{
+    g_gx_tetris_replay.ticks = 0;
+    while( g_gx_tetris_replay.ticks < ticks)
+    {
+        if( !virtualFireTheNextTimer())
+        {
+            return FALSE;
+        }
+    }
+    return g_gx_tetris_replay.ticks == ticks;
+}
+
+/*
+** Plays the recording in data from its start, or from a keyframe on, on
+** the virtual clock. Drawn, the screen shows every step as fast as it is
+** drawn, headless nothing is presented. Returns the keyframes which did not
+** match, or -1 if the replay could not be played to its end or the virtual
+** clock dropped a timer on the way.
+*/
+static S32 replayTheGame( U32 keyframe, BOOL headless)
+{
+    gx_tetris_replay_struct *replay = &g_gx_tetris_replay;
+    CTetrisSession session;
+    const U8    *p      = replay->data + REPLAY_HEADER_SIZE;
+    const U8    *end    = replay->data + replay->length;
+    const U8    *frame;
+    U8          snapshot[TETRIS_SNAPSHOT_SIZE];
+    U32         value, pieces, size, seen = 0, records = 0, dropped;
+    S32         differ  = 0;
+    BOOL        played  = FALSE;
+
+    if( replay->length < REPLAY_HEADER_SIZE || memcmp( replay->data, "TRP", 3) != 0 ||
+        replay->data[3] != REPLAY_VERSION || replay->data[4] != TETRIS_SNAPSHOT_VERSION)
+    {
+        debug( ";replay, not a replay of this version");
+        replayDrop();
+        return -1;
+    }
+
+    mmi_gx_tetris_exit_game();
+    keepTheSession( &session);
+    replay->playing         = TRUE;
+    g_gx_tetris_clock.on    = TRUE;
+    dropped                 = g_gx_tetris_clock.dropped;
+    tetris_headless         = headless;
+    GFX.is_aud_on           = FALSE;
+    tetris_random_seed      = replayGet32( replay->data + 5);
+    tetris_randomizer       = replay->data[9];
+    dummy_gamelevel_val     = replay->data[10] - 1;
+    tetris_snapshot_size    = 0;
+    g_gx_tetris_context.is_new_game = TRUE;
+#ifdef __TETRIS_GOLDEN__
+    goldenBegin();
+#endif
+    mmi_gx_tetris_enter_game();
+
+    if( me == NULL || me->gridRowNumber != replay->data[11] || me->gridColumnNumber != replay->data[12])
+    {
+        debug( ";replay, recorded on another screen");
+        goto _replayTheGame_return_;
+    }
+
+    while( p < end)
+    {
+        if( !replayGetVar( &p, end, &value))
+        {
+            break;
+        }
+        records ++;
+
+        if( ( value & 7) == REPLAY_KEYFRAME)
+        {
+            if( !replayGetVar( &p, end, &pieces) || end - p < 4)
+            {
+                break;
+            }
+            frame = p + 4;
+            if( !replayGetVar( &frame, end, &size) || (U32)( end - frame) < size || size > sizeof( snapshot))
+            {
+                break;
+            }
+            seen ++;
+            if( seen < keyframe)
+            {
+                p = frame + size;
+                continue;
+            }
+            if( seen == keyframe)
+            {
+                // start here, the step down is armed again by the redraw
+                killTimer();
+                memcpy( snapshot, frame, size);
+                if( !decodeTheGameSnapshot( snapshot, (U16)size))
+                {
+                    break;
+                }
+                replay->pieces        = pieces;
+                replay->keyframePiece = pieces;
+                redrawTheScreen();
+            }
+            else if( !replayWaitFor( value >> 3))
+            {
+                break;
+            }
+            if( replay->pieces != pieces ||
+                replayHashTheState( snapshot, encodeTheGameSnapshot( snapshot)) != replayGet32( p))
+            {
+                differ ++;
+                debug( ";replay, keyframe %d at piece %d differs, piece %d here", seen, pieces, replay->pieces);
+            }
+            p = frame + size;
+            continue;
+        }
+        if( seen < keyframe)
+        {
+            continue;
+        }
+
+        if( !replayWaitFor( value >> 3))
+        {
+            break;
+        }
+        switch( value & 7)
+        {
+            case ACTION_DOWN:       Tetris_8Key();              break;
+            case ACTION_LEFT:       Tetris_4Key();              break;
+            case ACTION_RIGHT:      Tetris_6Key();              break;
+            case ACTION_ROTATE:     Tetris_2Key();              break;
+            case ACTION_PAUSE:      Tetris_5Key();              break;
+            case REPLAY_CONTINUE:   continueAtTheNextLevel();   break;
+        }
+    }
+    played = p >= end && seen >= keyframe && g_gx_tetris_clock.dropped == dropped;
+    debug( ";replay, %d records, %d pieces, %d keyframes, %d differ%s",
+            records, replay->pieces, seen, differ,
+            g_gx_tetris_clock.dropped != dropped ? ", timers dropped" : played ? "" : ", stopped before the end");
+
+_replayTheGame_return_:
+    g_gx_tetris_context.is_new_game = TRUE; // the replayed game is not kept
+    mmi_gx_tetris_exit_game();
+#ifdef __TETRIS_GOLDEN__
+    goldenEnd();
+#endif
+    replayDrop();
+    g_gx_tetris_clock.on    = FALSE;
+    tetris_headless         = FALSE;
+    restoreTheSession( &session);
+    mmi_gx_tetris_enter_game();
+    return played ? differ : -1;
+}
+
+/* Reads a replay file into data, the game recorded so far is written first. */
+static BOOL replayLoadTheFile( const char *name)
+{
+    gx_tetris_replay_struct *replay = &g_gx_tetris_replay;
+    FS_HANDLE   file;
+    UINT        read = 0;
+
+    replaySave();
+    if( ( file = openTheFile( name, FS_READ_ONLY)) < FS_NO_ERROR)
+    {
+        return FALSE;
+    }
+    replay->playing = TRUE;
+    FS_Read( file, replay->data, REPLAY_SIZE, &read);
+    FS_Close( file);
+    replay->length = read;
+    return TRUE;
+}
+
+/* Plays tetris_replay.trp from its start or from its last keyframe. */
+static void replayTheFile( BOOL lastKeyframe, BOOL headless)
+{
+    gx_tetris_replay_struct *replay = &g_gx_tetris_replay;
+    const U8    *p;
+    const U8    *end;
+    U32         value, keyframes = 0;
+
+    if( !replayLoadTheFile( "tetris_replay.trp"))
+    {
+        return;
+    }
+
+    // the keyframes are counted on the way, a record of a key has nothing more
+    p   = replay->data + REPLAY_HEADER_SIZE;
+    end = replay->data + replay->length;
+    while( lastKeyframe && p < end && replayGetVar( &p, end, &value))
+    {
+        if( ( value & 7) == REPLAY_KEYFRAME)
+        {
+            if( !replayGetVar( &p, end, &value) || end - p < 4)
+            {
+                break;
+            }
+            p += 4;
+            if( !replayGetVar( &p, end, &value))
+            {
+                break;
+            }
+            p += value;
+            keyframes ++;
+        }
+    }
+    replayTheGame( keyframes, headless);
+}
+#endif /* __TETRIS_REPLAY__ */
+
+#ifdef __TETRIS_GOLDEN__
+/*
+** The golden run replays a fixed game, tetris_golden.trp, drawn on a
+** stand-in layer of the screen size. Every present hashes the whole layer
+** instead of a blit and takes what the draw paths did since the present
+** before. tetris_golden.gld holds the same of a run taken as right:
+**
+**   'T', 'G', 'F', GOLDEN_VERSION
+**   screen width, height                       (U16, low byte first)
+**   randomSeed of the game                     (U32)
+**   frames, each one hash, fills, blits, pixels, presented (U32)
+**
+** Without tetris_golden.trp the last recorded game becomes it, without
+** tetris_golden.gld the run writes it. Both are deleted by hand to take
+** another game or new golden frames.
+*/
+#define GOLDEN_HEADER_SIZE  12
+#define GOLDEN_FRAME_SIZE   20
+
+/* Before the replay enters the game, the drawing goes to the stand-in layer from here. */
+static void goldenBegin( void)
+{
+    gx_tetris_golden_struct *golden = &g_gx_tetris_golden;
+
+    if( !golden->on)
+    {
+        return;
+    }
+    if( gdi_layer_create( 0, 0, UI_device_width, UI_device_height, &golden->layer) != GDI_LAYER_SUCCEED)
+    {
+        debug( ";golden, no stand-in layer");
+        return;
+    }
+    gdi_layer_push_and_set_active( golden->layer);
+    gdi_layer_push_clip();
+    gdi_layer_set_clip( 0, 0, UI_device_width - 1, UI_device_height - 1);
+    gui_fill_rectangle( 0, 0, UI_device_width - 1, UI_device_height - 1, gui_color( 0, 0, 0));
+#ifdef __TETRIS_PERF_HUD__
+    // the overlay shows timings, no two runs would draw the same
+    golden->hud = g_gx_tetris_hud.on;
+    g_gx_tetris_hud.on = FALSE;
+#endif
+    golden->last   = tetris_render_count;
+    golden->active = TRUE;
+}
+
+/* A present during the run, hashed and compared with the next golden frame. */
+static void goldenFrame( void)
+{
+    gx_tetris_golden_struct *golden = &g_gx_tetris_golden;
+    CGoldenFrame    frame, stored;
+    U8              record[GOLDEN_FRAME_SIZE];
+    U8              *buffer = NULL;
+    U8              *p;
+    S32             width   = 0;
+    S32             height  = 0;
+    U32             size, i;
+    UINT            done    = 0;
+
+    gdi_layer_get_buffer_ptr( &buffer);
+    gdi_layer_get_dimension( &width, &height);
+    size = (U32)width * height * ( gdi_layer_get_bit_per_pixel() >> 3);
+    frame.hash = 2166136261U;
+    for( i = 0; buffer != NULL && i < size; i ++)
+    {
+        frame.hash = ( frame.hash ^ buffer[i]) * 16777619U;
+    }
+    frame.fills     = tetris_render_count.fills     - golden->last.fills;
+    frame.blits     = tetris_render_count.blits     - golden->last.blits;
+    frame.pixels    = tetris_render_count.pixels    - golden->last.pixels;
+    frame.presented = tetris_render_count.presented - golden->last.presented;
+    tetris_render_count.frameStart = 0; // nothing reached the LCD, there is no frame time
+    golden->last = tetris_render_count;
+    golden->frames ++;
+
+    golden->run.hash       = ( golden->run.hash ^ frame.hash) * 16777619U;
+    golden->run.fills     += frame.fills;
+    golden->run.blits     += frame.blits;
+    golden->run.pixels    += frame.pixels;
+    golden->run.presented += frame.presented;
+
+    if( golden->writing)
+    {
+        p = record;
+        SNAPSHOT_PUT32( p, frame.hash);
+        SNAPSHOT_PUT32( p, frame.fills);
+        SNAPSHOT_PUT32( p, frame.blits);
+        SNAPSHOT_PUT32( p, frame.pixels);
+        SNAPSHOT_PUT32( p, frame.presented);
+        FS_Write( golden->file, record, GOLDEN_FRAME_SIZE, &done);
+        return;
+    }
+
+    FS_Read( golden->file, record, GOLDEN_FRAME_SIZE, &done);
+    if( done != GOLDEN_FRAME_SIZE)
+    {
+        return; // past the golden frames, told by the count in the report
+    }
+    p = record;
+    stored.hash      = SNAPSHOT_GET32( p);
+    stored.fills     = SNAPSHOT_GET32( p);
+    stored.blits     = SNAPSHOT_GET32( p);
+    stored.pixels    = SNAPSHOT_GET32( p);
+    stored.presented = SNAPSHOT_GET32( p);
+    golden->stored ++;
+
+    golden->golden.hash       = ( golden->golden.hash ^ stored.hash) * 16777619U;
+    golden->golden.fills     += stored.fills;
+    golden->golden.blits     += stored.blits;
+    golden->golden.pixels    += stored.pixels;
+    golden->golden.presented += stored.presented;
+
+    if( frame.hash != stored.hash)
+    {
+        if( golden->differ ++ < GOLDEN_REPORTED)
+        {
+            debug( ";golden, frame %d differs, fills %d/%d, blits %d/%d, pixels %d/%d",
+                    golden->frames, frame.fills, stored.fills, frame.blits, stored.blits,
+                    frame.pixels, stored.pixels);
+        }
+        if( golden->first == 0)
+        {
+            golden->first = golden->frames;
+        }
+    }
+}
+
+/* After the replay left the game, the drawing goes back to the screen. */
+static void goldenEnd( void)
+{
+    gx_tetris_golden_struct *golden = &g_gx_tetris_golden;
+
+    if( !golden->active)
+    {
+        return;
+    }
+    golden->active = FALSE;
+    gdi_layer_pop_clip();
+    gdi_layer_pop_and_restore_active();
+    gdi_layer_free( golden->layer);
+#ifdef __TETRIS_PERF_HUD__
+    g_gx_tetris_hud.on = golden->hud;
+#endif
+}
+
+/* A golden run, the frames are written if there are none yet, see the format. */
+static void goldenTheGame( void)
+{
+    gx_tetris_golden_struct *golden = &g_gx_tetris_golden;
+    gx_tetris_replay_struct *replay = &g_gx_tetris_replay;
+    CGoldenFrame    *run    = &golden->run;
+    CGoldenFrame    *gold   = &golden->golden;
+    U8              header[GOLDEN_HEADER_SIZE];
+    U8              stored[GOLDEN_HEADER_SIZE];
+    U8              *p      = header;
+    FS_HANDLE       file;
+    UINT            done    = 0;
+    U32             left    = 0;
+    S32             played;
+
+    // the fixed game, the last one recorded becomes it the first time
+    if( !replayLoadTheFile( "tetris_golden.trp"))
+    {
+        if( !replayLoadTheFile( "tetris_replay.trp"))
+        {
+            debug( ";golden, no recorded game");
+            return;
+        }
+        if( ( file = openTheFile( "tetris_golden.trp", FS_CREATE_ALWAYS | FS_READ_WRITE)) >= FS_NO_ERROR)
+        {
+            FS_Write( file, replay->data, replay->length, &done);
+            FS_Close( file);
+        }
+    }
+
+    memset( golden, 0, sizeof( gx_tetris_golden_struct));
+    golden->run.hash    = 2166136261U;
+    golden->golden.hash = 2166136261U;
+    SNAPSHOT_PUT8( p, 'T');
+    SNAPSHOT_PUT8( p, 'G');
+    SNAPSHOT_PUT8( p, 'F');
+    SNAPSHOT_PUT8( p, GOLDEN_VERSION);
+    SNAPSHOT_PUT16( p, UI_device_width);
+    SNAPSHOT_PUT16( p, UI_device_height);
+    SNAPSHOT_PUT32( p, replay->length >= REPLAY_HEADER_SIZE ? replayGet32( replay->data + 5) : 0);
+
+    if( ( golden->file = openTheFile( "tetris_golden.gld", FS_READ_ONLY)) >= FS_NO_ERROR)
+    {
+        FS_Read( golden->file, stored, GOLDEN_HEADER_SIZE, &done);
+        if( done != GOLDEN_HEADER_SIZE || memcmp( stored, header, GOLDEN_HEADER_SIZE) != 0)
+        {
+            FS_Close( golden->file);
+            replayDrop();
+            debug( ";golden, tetris_golden.gld is of another game, screen or version");
+            return;
+        }
+    }
+    else
+    {
+        if( ( golden->file = openTheFile( "tetris_golden.gld", FS_CREATE_ALWAYS | FS_READ_WRITE)) < FS_NO_ERROR)
+        {
+            replayDrop();
+            return;
+        }
+        FS_Write( golden->file, header, GOLDEN_HEADER_SIZE, &done);
+        golden->writing = TRUE;
+    }
+
+    golden->on = TRUE;
+    played = replayTheGame( 0, FALSE);
+    golden->on = FALSE;
+
+    // golden frames the run did not reach
+    while( !golden->writing && FS_Read( golden->file, stored, GOLDEN_HEADER_SIZE, &done) >= FS_NO_ERROR && done > 0)
+    {
+        left += done;
+    }
+    FS_Close( golden->file);
+
+    debug( ";golden, %d frames, %s, hash %08x", golden->frames,
+            played < 0 ? "the replay stopped or dropped a timer" : played > 0 ? "the game took another course" : "the game as recorded",
+            run->hash);
+    if( golden->writing)
+    {
+        debug( ";golden, written, fills %d, blits %d, pixels %d, presented %d",
+                run->fills, run->blits, run->pixels, run->presented);
+        return;
+    }
+    debug( ";golden, %d golden frames, %d differ, the first is %d, hash %08x",
+            golden->stored + left / GOLDEN_FRAME_SIZE, golden->differ, golden->first, gold->hash);
+    debug( ";golden, run/golden, fills %d/%d, blits %d/%d, pixels %d/%d, presented %d/%d",
+            run->fills, gold->fills, run->blits, gold->blits, run->pixels, gold->pixels,
+            run->presented, gold->presented);
+}
+#endif /* __TETRIS_GOLDEN__ */
+
+#ifdef __TETRIS_SOAK__
+/*
+** The soak plays the game headless as fast as it goes on the virtual
+** clock, the pieces are placed through the key handlers by a greedy driver with some random ones
+** among them. Every cycle enters the game, plays until a game over, the
+** last level or a random number of pieces and leaves it again, a game left
+** early is resumed from its snapshot by the next cycle. After every piece
+** gridRowMap is checked against gridMatrix, after every cycle no timer may
+** be pending and no control buffer in use.
+*/
+static U32 soakRandom( void)
+{
+    g_gx_tetris_soak.random = g_gx_tetris_soak.random * 1103515245 + 12345;
+    return ( g_gx_tetris_soak.random >> 16) & 0x7fff;
+}
+
+static void soakFail( const char *what, S32 a, S32 b)
+{
+    g_gx_tetris_soak.failures ++;
+    debug( ";soak failure, %s, %d, %d, cycle %d, piece %d",
+            what, a, b, g_gx_tetris_soak.cycles, tetris_pieces_launched);
+}
+
+static void soakCheckTheBoard( void)
+{
+    U16 bits;
+    int i, j;
+
+    for( i = 0; i < me->gridRowNumber; i ++)
+    {
+        bits = 0;
+        for( j = 0; j < me->gridColumnNumber; j ++)
+        {
+            bits |= me->gridMatrix[i][j].dirty ? 1 << ( me->gridColumnNumber - 1 - j) : 0;
+        }
+        if( bits != me->gridRowMap[i])
+        {
+            soakFail( "gridRowMap is not gridMatrix at row", i, me->gridRowMap[i] ^ bits);
+            me->gridRowMap[i] = bits; // reported once
+        }
+    }
+}
+
+/* Deeper is better, a full row much better, a hole under the tetris worse. */
+static S32 soakScoreTheLanding( const CTetris *falling)
+{
+    CTetris tetris;
+    U16     bits[4];
+    S32     score = 0;
+    int     i, j, row, col;
+
+    memcpy( &tetris, falling, sizeof( tetris));
+    while( canDoAction( &tetris, ACTION_DOWN))
+        ;
+
+    for( i = 0; i < 4; i ++)
+    {
+        row = ( tetris.block[i].y - me->playingZone.y) / me->gridSideLength;
+        col = ( tetris.block[i].x - me->playingZone.x) / me->gridSideLength;
+        bits[i] = me->gridRowMap[row] | 1 << ( me->gridColumnNumber - 1 - col);
+        score += row;
+        for( j = 0; j < i; j ++)
+        {
+            if( tetris.block[j].y == tetris.block[i].y)
+            {
+                bits[i] |= bits[j];
+                bits[j]  = 0;
+            }
+        }
+        if( !theGridIsDirtyOrInvalid( tetris.block[i].x, tetris.block[i].y + me->gridSideLength))
+        {
+            score -= 4;
+        }
+    }
+    for( i = 0; i < 4; i ++)
+    {
+        score += bits[i] == me->gridRowMask ? 100 : 0;
+    }
+    return score;
+}
+
+/* Turns and moves the falling tetris with the keys and drops it. */
+static void soakPlaceThePiece( void)
+{
+    CTetris tetris, turned;
+    S32     score, bestScore = -0x7fffffff;
+    int     rotations, shift, bestRotations = 0, bestShift = 0;
+
+    if( soakRandom() % SOAK_RANDOM_ODDS == 0)
+    {
+        bestRotations = soakRandom() % 4;
+        bestShift     = ( int)( soakRandom() % 11) - 5;
+    }
+    else
+    {
+        memcpy( &turned, &me->theFallingTetris, sizeof( turned));
+        for( rotations = 0; rotations < 4; rotations ++)
+        {
+            // the same turns Tetris_2Key makes
+            if( rotations > 0 && ( turned.model == 6 || !canDoAction( &turned, ACTION_ROTATE)))
+            {
+                break;
+            }
+            memcpy( &tetris, &turned, sizeof( tetris));
+            for( shift = 0; canDoAction( &tetris, ACTION_LEFT); shift --)
+                ;
+            do
+            {
+                score = soakScoreTheLanding( &tetris);
+                if( score > bestScore)
+                {
+                    bestScore     = score;
+                    bestRotations = rotations;
+                    bestShift     = shift;
+                }
+                shift ++;
+            } while( canDoAction( &tetris, ACTION_RIGHT));
+        }
+    }
+
+    for( ; bestRotations > 0; bestRotations --)
+    {
+        Tetris_2Key();
+    }
+    for( ; bestShift < 0; bestShift ++)
+    {
+        Tetris_4Key();
+    }
+    for( ; bestShift > 0; bestShift --)
+    {
+        Tetris_6Key();
+    }
+    Tetris_8Key();
+}
+
+static void soakOneCycle( void)
+{
+    gx_tetris_soak_struct *soak = &g_gx_tetris_soak;
+    U32 leaveAt;
+    U32 dropped = g_gx_tetris_clock.dropped;
+    int i;
+
+    soak->cycles ++;
+    if( g_gx_tetris_context.is_new_game)
+    {
+        dummy_gamelevel_val = soakRandom() % MAX_LEVEL;
+        tetris_random_seed  = soakRandom() << 15 | soakRandom();
+        tetris_randomizer   = soak->games & 1 ? RANDOMIZER_BAG : RANDOMIZER_UNIFORM;
+        soak->games ++;
+    }
+    mmi_gx_tetris_enter_game();
+    leaveAt = tetris_pieces_launched + 1 + soakRandom() % SOAK_CYCLE_PIECES;
+
+    for( ;;)
+    {
+        if( g_gx_tetris_context.gameState == GAME_STATE_REPORT)
+        {
+            break;
+        }
+        if( g_gx_tetris_context.gameState == GAME_STATE_LASTLEVEL)
+        {
+            g_gx_tetris_context.is_new_game = TRUE; // as if the prompt was left
+            break;
+        }
+        if( g_gx_tetris_context.gameState == GAME_STATE_NEXTLEVEL)
+        {
+            soak->levels ++;
+            Tetris_5Key();
+            continue;
+        }
+        if( g_gx_tetris_context.gameState == GAME_STATE_PAUSED)
+        {
+            Tetris_5Key();
+            continue;
+        }
+        if( g_gx_tetris_context.gameState == GAME_STATE_RUNNING && !me->theFallingTetris.pinned &&
+            me->flashCounterWhenDeleteDirtyRows == 0 && soak->planned != tetris_pieces_launched)
+        {
+            if( tetris_pieces_launched >= leaveAt)
+            {
+                soak->suspends ++;
+                break;
+            }
+            soak->planned = tetris_pieces_launched;
+            soakCheckTheBoard();
+            if( soakRandom() % SOAK_PAUSE_ODDS == 0)
+            {
+                soak->pauses ++;
+                Tetris_5Key();
+                continue;
+            }
+            soakPlaceThePiece();
+            continue;
+        }
+        if( !virtualFireTheNextTimer())
+        {
+            soakFail( "nothing to do in state", g_gx_tetris_context.gameState, 0);
+            g_gx_tetris_context.is_new_game = TRUE;
+            break;
+        }
+    }
+
+    mmi_gx_tetris_exit_game();
+    for( i = 0; i < VIRTUAL_TIMERS; i ++)
+    {
+        if( g_gx_tetris_clock.timer[i].callback != NULL)
+        {
+            soakFail( "timer pending after exit, slot", i, 0);
+            g_gx_tetris_clock.timer[i].callback = NULL;
+        }
+    }
+    if( g_gx_tetris_clock.dropped != dropped)
+    {
+        soakFail( "timers dropped, pending at most", g_gx_tetris_clock.dropped - dropped, VIRTUAL_TIMERS);
+    }
+    if( g_gx_tetris_memory.current != soak->inUse)
+    {
+        soakFail( "control buffer bytes in use after exit", g_gx_tetris_memory.current, soak->inUse);
+        memoryReport();
+        soak->inUse = g_gx_tetris_memory.current; // reported once
+    }
+}
+
+/* Leaves the game, soaks, puts back the settings and the game it found and enters again. */
+static void soakTheGame( void)
+{
+    gx_tetris_soak_struct *soak = &g_gx_tetris_soak;
+    CTetrisSession session;
+    U32         start, ticks, pieces;
+
+    mmi_gx_tetris_exit_game();
+    keepTheSession( &session);
+
+    memset( soak, 0, sizeof( *soak));
+    soak->random  = SOAK_SEED;
+    soak->planned = tetris_pieces_launched;
+    pieces        = tetris_pieces_launched;
+    g_gx_tetris_clock.on = TRUE;
+    tetris_headless = TRUE;
+    GFX.is_aud_on = FALSE;
+    tetris_snapshot_size = 0;
+    g_gx_tetris_context.is_new_game = TRUE;
+
+    start = drv_get_current_time();
+    while( tetris_pieces_launched - pieces < SOAK_PIECES)
+    {
+        soakOneCycle();
+    }
+    ticks  = drv_get_current_time() - start;
+    pieces = tetris_pieces_launched - pieces;
+
+    g_gx_tetris_clock.on = FALSE;
+    tetris_headless = FALSE;
+    restoreTheSession( &session);
+
+    debug( ";soak %d pieces, %d cycles, %d games, %d levels, %d pauses, %d suspends, %d failures, %d pieces/s",
+            pieces, soak->cycles, soak->games, soak->levels, soak->pauses, soak->suspends, soak->failures,
+            ticks ? ( U32)(( double)pieces * 32768 / ticks) : 0);
+    mmi_gx_tetris_enter_game();
+}
+#endif /* __TETRIS_SOAK__ */
+
+static void displaySplashScreen(  void)
+{
+	U32	iImgWdt,iImgHgt;
+	U32 iStrWdt,iStrHgt;
+	PU8 pTitleString;
+	TetRect rect;
+
+	iImgWdt = tetris_bundle_index[TETRIS_ASSET_SPLASH].width;
+	iImgHgt = tetris_bundle_index[TETRIS_ASSET_SPLASH].height;
+	gui_set_clip(0, 0, UI_device_width - 1, UI_device_height - 1);
+	gui_fill_rectangle(0, 0, UI_device_width - 1, UI_device_height - 1, gui_color(0x0, 0xcf, 0xff));
+	drawBundleImage(TETRIS_ASSET_SPLASH, (UI_device_width - iImgWdt)  >> 1,
+                       				UI_device_width - iImgHgt);
+	pTitleString = GetString(STR_GX_TETRIS_GAME_NAME);
+	gui_measure_string((UI_string_type)pTitleString, &iStrWdt, &iStrHgt);
+	rect.dx  = iStrWdt;
+    rect.x   = ( UI_device_width - rect.dx) >> 1;
+    rect.y   = ( UI_device_width - iImgHgt - iStrHgt) >> 1;
+    draw3DText( rect.x, rect.y, (UI_string_type)pTitleString);
+	gui_BLT_double_buffer(0, 0, UI_device_width - 1, UI_device_height - 1);
+	
+	playMusic(MUSIC_TITLE);
+}
+
+static void drawText3( S16 x, S16 y, UI_string_type text, RGBVAL color2draw, U32 flags)
+{
+	color saved_color;
+	S32	str_wdt;
+	S32 str_hgt;
+
+	saved_color = gui_get_text_color();
+	gui_set_text_color(gui_color(color2draw.r, color2draw.g, color2draw.b));
+	gui_measure_string(text, &str_wdt, &str_hgt);
+
+    if (r2lMMIFlag)
+    {
+        gui_move_text_cursor(x + str_wdt, y);
+    }
+    else
+    {
+        gui_move_text_cursor(x, y);
+    }
+	
+	gui_print_text(text);
+	gui_set_text_color(saved_color);
+}
+
+static void draw3DText( S16 x, S16 y, UI_string_type text)
+{
+	RGBVAL color1;
+	RGBVAL color2;
+	RGBVAL color3;
+
+	color1.r = color1.g = color1.b = 0xff;
+	color2.r = color2.g = color2.b = 0x00;
+	color3.r = 0xff;
+	color3.g = 0xcc;
+	color3.b = 0x00;
+	//drawText3( x, y - 1, text, color1, 0);
+	//drawText3( x - 1, y + 1, text, color2, 0);
+    //drawText3( x + 1, y + 1, text, color2, 0);
+    drawText3( x, y, text, color3, 0);
+}
+
+
+static void drawPlayingZoneBorder( void)
+{
+
+    TetRect rect;
+
+    // to clear the screen with background color
+    rect.x  = 0;
+    rect.y  = 0;
+    rect.dx = me->screenWidth;
+    rect.dy = me->screenHeight;
+	fillRectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,COLOR_BACKGROUND);
+
+    // to draw the border of the playing zone
+    // 1. draw inner border
+    rect.x  =  me->playingZone.x - 1;
+    rect.y  =  me->playingZone.y - 1;
+    rect.dx = me->playingZone.dx + 2;
+    rect.dy = me->playingZone.dy + 2;
+	fillRectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,gui_color(20,90,141));
+    // 2. draw outer border
+    rect.x  -=  1;
+    rect.y  -=  1;
+    rect.dx += 2;
+    rect.dy += 2;
+	fillRectangle(rect.x,rect.y,rect.x+rect.dx,rect.y+rect.dy-1,COLOR_BACKGROUND);
+
+    // to draw grid lines
+    if( me->drawGridLines)
+    {
+        drawGridLines();
+    }
+
+}
+
+static void drawGridLines( void)
+{
+
+    int     i = 0;
+    int     x,y,ey;
+
+    x = me->playingZone.x - 1;
+    y = me->playingZone.y - 1;
+    ey = me->playingZone.y + me->playingZone.dy - 1;
+    for(i = 1; i < me->gridColumnNumber; i ++)
+    {
+        x += me->gridSideLength;
+		fillRectangle(x-1,y,x,ey,gui_color(0,0,0x8b));
+    }
+} // drawGridLines
+
+static void promptTheGameIsPausedNow( void)
+{
+
+    int16   x       = 0;
+    int16   y       = 0;
+	U32	iImgWdt,iImgHgt;
+	
+	iImgWdt = tetris_bundle_index[TETRIS_ASSET_GAMEPAUSE_EN].width;
+	iImgHgt = tetris_bundle_index[TETRIS_ASSET_GAMEPAUSE_EN].height;
+	
+    x = ( ( me->playingZone.dx - iImgWdt) >> 1) + me->playingZone.x;
+    y = ( ( me->playingZone.dy - iImgHgt) >> 1) + me->playingZone.y;
+
+    // keep what the prompt covers, resuming puts it back with one blit
+    saveTheCoveredArea( x, y, iImgWdt, iImgHgt);
+	drawBundleImage(TETRIS_ASSET_GAMEPAUSE_EN, x, y);
+	
+    presentTheScreen();
+} // promptTheGameIsPausedNow
+
+static boolean saveTheCoveredArea( int16 x, int16 y, int16 dx, int16 dy)
+{
+
+    releaseTheCoveredArea();
+    me->coveredAreaPixels.buf_ptr = TETRIS_ALLOC( dx * dy * ( GDI_MAINLCD_BIT_PER_PIXEL >> 3));
+    if( me->coveredAreaPixels.buf_ptr == NULL)
+    {
+        debug( ";allocating the covered area failed, the screen will be redrawn");
+        return FALSE;
+    }
+
+    SETAEERECT( &me->coveredArea, x, y, dx, dy);
+    gdi_image_cache_bmp_get( x, y, x + dx - 1, y + dy - 1, &me->coveredAreaPixels);
+    return TRUE;
+}
+
+static boolean restoreTheCoveredArea( void)
+{
+
+    TetRect *area = &me->coveredArea;
+
+    if( me->coveredAreaPixels.buf_ptr == NULL)
+    {
+        return FALSE;
+    }
+
+    gdi_image_cache_bmp_draw( area->x, area->y, &me->coveredAreaPixels);
+    markTheDamagedArea( area->x, area->y, area->x + area->dx - 1, area->y + area->dy - 1);
+    presentTheScreen();
+
+    releaseTheCoveredArea();
+    return TRUE;
+}
+
+static void releaseTheCoveredArea( void)
+{
+
+    if( me->coveredAreaPixels.buf_ptr != NULL)
+    {
+        TETRIS_FREE( me->coveredAreaPixels.buf_ptr);
+        me->coveredAreaPixels.buf_ptr = NULL;
+    }
+}
+
+static void drawPopWindowFrameBorder( uint16 titleID, TetRect * fRect)
+{
+
+    S32             titleWidth  = 0;
+    S32             titleHeight = 0;
+    UI_string_type  title       = NULL;
+
+    fillRectangle( fRect->x, fRect->y, fRect->x + fRect->dx - 1, fRect->y + fRect->dy - 1,
+            gui_color(20,90,141));
+    fillRectangle( fRect->x + 2, fRect->y + 2, fRect->x + fRect->dx - 3, fRect->y + fRect->dy - 3,
+            gui_color(0, 0xcf, 0xff));
+
+    if( titleID != 0)
+    {
+        title = (UI_string_type)GetString( titleID);
+        gui_measure_string( title, &titleWidth, &titleHeight);
+        draw3DText( fRect->x + ( ( fRect->dx - titleWidth) >> 1), fRect->y + 2, title);
+    }
+}
+
+// Breaks the text into lines at spaces so that every line fits into the rect,
+// returns the height of the lines. Nothing is drawn if measureOnly.
+static int16 drawWrappedText( TetRect *rect, UI_string_type text, boolean measureOnly)
+{
+
+    WCHAR   line[64];
+    S32     width       = 0;
+    S32     height      = 0;
+    int     length      = 0;
+    int     lastSpace   = -1;
+    int16   y           = rect->y;
+    RGBVAL  black       = {0x00, 0x00, 0x00};
+
+    while( TRUE)
+    {
+        WCHAR c = *text;
+
+        if( c != 0 && c != '\n' && length < 63)
+        {
+            line[length] = c;
+            line[length + 1] = 0;
+            gui_measure_string( (UI_string_type)line, &width, &height);
+            if( width <= rect->dx || lastSpace < 0)
+            {
+                if( c == ' ')
+                {
+                    lastSpace = length;
+                }
+                length ++;
+                text ++;
+                continue;
+            }
+            // step back to the last space, the word goes to the next line
+            text  -= length - lastSpace - 1;
+            length = lastSpace;
+        }
+
+        line[length] = 0;
+        if( !measureOnly && length > 0)
+        {
+            gui_measure_string( (UI_string_type)line, &width, &height);
+            drawText3( width < rect->dx ? rect->x + ( ( rect->dx - width) >> 1) : rect->x,
+                    y, (UI_string_type)line, black, 0);
+        }
+        y += me->fontHeight + 1;
+
+        if( *text == 0)
+        {
+            break;
+        }
+        if( *text == '\n' || *text == ' ')
+        {
+            text ++;
+        }
+        length      = 0;
+        lastSpace   = -1;
+    }
+
+    return y - rect->y;
+} // drawWrappedText
+
+// The level prompt is drawn over the playing zone, the board, the layers and
+// the images stay as they are and continuing just puts the covered pixels back.
+static void promptTheLevelIsPassedNow( void)
+{
+
+    TetRect frame;
+    TetRect textRect;
+    S32     width   = 0;
+    S32     height  = 0;
+    UI_string_type leftKey  = NULL;
+    UI_string_type rightKey = NULL;
+    RGBVAL  black   = {0x00, 0x00, 0x00};
+
+    textRect.x  = me->playingZone.x + me->gridSideLength + 4;
+    textRect.dx = me->playingZone.dx - ( me->gridSideLength << 1) - 8;
+    textRect.y  = 0;
+    textRect.dy = 0;
+    textRect.dy = drawWrappedText( &textRect, (UI_string_type)drawee_string, TRUE);
+
+    frame.x  = textRect.x - 4;
+    frame.dx = textRect.dx + 8;
+    frame.dy = textRect.dy + ( me->fontHeight << 1) + 16;
+    frame.dy = frame.dy > me->playingZone.dy ? me->playingZone.dy : frame.dy;
+    frame.y  = me->playingZone.y + ( ( me->playingZone.dy - frame.dy) >> 1);
+    textRect.y = frame.y + me->fontHeight + 6;
+
+    saveTheCoveredArea( frame.x, frame.y, frame.dx, frame.dy);
+    drawPopWindowFrameBorder( STR_GX_TETRIS_GAME_NAME, &frame);
+    drawWrappedText( &textRect, (UI_string_type)drawee_string, FALSE);
+
+    // soft key hints at the bottom of the frame
+    rightKey = (UI_string_type)GetString( me->gameState == GAME_STATE_NEXTLEVEL ? STR_GLOBAL_NO : STR_GLOBAL_BACK);
+    gui_measure_string( rightKey, &width, &height);
+    drawText3( frame.x + frame.dx - width - 4, frame.y + frame.dy - me->fontHeight - 4, rightKey, black, 0);
+    if( me->gameState == GAME_STATE_NEXTLEVEL)
+    {
+        leftKey = (UI_string_type)GetString( STR_GLOBAL_YES);
+        drawText3( frame.x + 4, frame.y + frame.dy - me->fontHeight - 4, leftKey, black, 0);
+        SetKeyHandler( continueAtTheNextLevel, KEY_LSK, KEY_EVENT_UP);
+    }
+    presentTheScreen();
+} // promptTheLevelIsPassedNow
+
+static void continueAtTheNextLevel( void)
+{
+
+    if( me->gameState != GAME_STATE_NEXTLEVEL)
+    {
+        return;
+    }
+
+    REPLAY_KEY( REPLAY_CONTINUE);
+    WATCHDOG_ENTER( WATCHDOG_NEXT_LEVEL, continueAtTheNextLevel);
+    ClearKeyHandler( KEY_LSK, KEY_EVENT_UP);
+    me->gameLevel = me->gameLevel < MAX_LEVEL ? me->gameLevel + 1 : MAX_LEVEL;
+    tetris_nextlevel = FALSE;
+    setGameState(GAME_STATE_RUNNING);
+
+    if( !restoreTheCoveredArea())
+    {
+        redrawTheScreen();
+        gui_cancel_timer(moveDownwardsIf);
+    }
+
+    // the last tetris was pinned before the level was passed, rows above it
+    // may have been deleted since, so its grids are repainted from the matrix
+    restoreTheGridsUnderTheTetris( &me->theFallingTetris);
+    me->theFallingTetris.pinned = FALSE;
+    launchOneTetris();
+    WATCHDOG_LEAVE();
+    REPLAY_KEY_DONE();
+} // continueAtTheNextLevel
+
+static void drawGameScoreAndGameSpeed( void)
+{
+
+    uint16  x           = 0;
+    uint16  y           = 0;
+    uint16  digitWidth  = 0;
+    int8    i           = 0;
+    uint16  power       = 0;
+	const CBundleEntry *image = NULL;
+	
+	image = &tetris_bundle_index[TETRIS_ASSET_GAMESCORE_EN];
+    x = me->screenWidth - image->width;
+    y = me->yWhereToDrawTheNextFallingTetris + 4 * me->gridSideLength;
+	drawBundleImage(TETRIS_ASSET_GAMESCORE_EN, x, y);
+	y += image->height + 2;
+	
+    x = me->screenWidth;
+    for( i = 0, power = 1; i < 4; i ++, power *= 10)
+    {
+		image = &tetris_bundle_index[TETRIS_ASSET_DIGIT_0 + me->gameScore / power % 10];
+        x -= image->width + 2;
+        drawBundleImage(TETRIS_ASSET_DIGIT_0 + me->gameScore / power % 10, x, y);
+    }
+
+	image = &tetris_bundle_index[TETRIS_ASSET_GAMESPEED_EN];
+    x = me->screenWidth - image->width;
+    y += image->height + 6;
+	drawBundleImage(TETRIS_ASSET_GAMESPEED_EN, x, y);
+
+    y += image->height + 2;
+    x = me->screenWidth;
+    for( i = 0, power = 1; i < 4; i ++, power *= 10)
+    {
+		image = &tetris_bundle_index[TETRIS_ASSET_DIGIT_0 + me->gameSpeed / power % 10];
+        x -= image->width + 2;
+        drawBundleImage(TETRIS_ASSET_DIGIT_0 + me->gameSpeed / power % 10, x, y);
+    }
+
+
+}
+
+static void redrawTheScreen( void)
+{
+    int  i,j;
     char tetrisModel;
     TetRect rect;
 
+    WATCHDOG_STEP( redrawTheScreen);
     resetControlsAndClearScreen(  TRUE);
     drawPlayingZoneBorder();
     drawGameScoreAndGameSpeed();
 
     me->flashCounterWhenDeleteDirtyRows = 0;
     me->dirtyRowNumber                  = 0;
+    me->theGhost.drawn                  = FALSE;
     rect.dx                             = me->gridSideLength - 1;
     rect.dy                             = rect.dx;
 
@@ -1390,7 +4846,7 @@ static void redrawTheScreen( void)
                 rect.y      = i * me->gridSideLength + me->playingZone.y;
                 tetrisModel     = me->gridMatrix[i][j].tetrisModel;
 
-				gui_fill_rectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,
+				fillRectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,
 								  gui_color(COLOR_PALETTE[tetrisModel].r,COLOR_PALETTE[tetrisModel].g,
 								  		    COLOR_PALETTE[tetrisModel].b));
             }
@@ -1404,18 +4860,289 @@ static void redrawTheScreen( void)
     {
         promptTheGameIsPausedNow();
     }
-    else if(me->gameState == GAME_STATE_NEXTLEVEL)
+    else if(me->gameState == GAME_STATE_NEXTLEVEL || me->gameState == GAME_STATE_LASTLEVEL)
     {
-        gotoNextLevel(FALSE);
+        promptTheLevelIsPassedNow();
     }
     else if(me->gameState == GAME_STATE_RUNNING)
     {
-        moveDownwardsIf();
+        // a full period before the next step, like after a pause
+        startGameTimer(me->sleepTime, moveDownwardsIf);
+    }
+    else
+    {
+        presentTheScreen();
+    }
+}
+
+static void markTheDamagedArea( int16 x1, int16 y1, int16 x2, int16 y2)
+{
+
+    // not me, the splash screen is drawn before the board is allocated
+    TetRect *area = &g_gx_tetris_context.damagedArea;
+
+    if( x2 < x1 || y2 < y1)
+    {
+        return;
+    }
+
+    if( area->dx == 0)
+    {
+        SETAEERECT( area, x1, y1, x2 - x1 + 1, y2 - y1 + 1);
+        return;
+    }
+
+    if( x1 < area->x)
+    {
+        area->dx += area->x - x1;
+        area->x   = x1;
+    }
+    if( y1 < area->y)
+    {
+        area->dy += area->y - y1;
+        area->y   = y1;
+    }
+    if( x2 >= area->x + area->dx)
+    {
+        area->dx = x2 - area->x + 1;
+    }
+    if( y2 >= area->y + area->dy)
+    {
+        area->dy = y2 - area->y + 1;
+    }
+}
+
+static void fillRectangle( int16 x1, int16 y1, int16 x2, int16 y2, color fillColor)
+{
+
+    markTheDamagedArea( x1, y1, x2, y2);
+    RENDER_COUNT( fills, x2 - x1 + 1, y2 - y1 + 1);
+    gui_fill_rectangle( x1, y1, x2, y2, fillColor);
+}
+
+static void showTransparentImage( int16 x, int16 y, PU8 image, color transparentColor)
+{
+
+    S32 width   = 0;
+    S32 height  = 0;
+
+    gui_measure_image( image, &width, &height);
+    markTheDamagedArea( x, y, x + width - 1, y + height - 1);
+    RENDER_COUNT( blits, width, height);
+    gui_show_transparent_image( x, y, image, transparentColor);
+}
+
+// Gives the BUNDLE_SPANS565 layout of an entry, expanding it into RAM on
+// first use if it is BUNDLE_SPANS8. NULL if there is no memory for it.
+static const U8 *loadBundleEntry( U8 index)
+{
+
+    const CBundleEntry  *entry  = &tetris_bundle_index[index];
+    CBundleCache        *cache  = &tetris_bundle_cache[index];
+    const U8            *blob   = tetris_bundle + entry->offset;
+    const U16           *palette;
+    U16                 spanBytes;
+    U16                 colors;
+    U16                 pixels;
+    U16                 *pixel;
+    U32                 ticks;
+    int                 i;
+
+    cache->uses ++;
+    if( cache->data != NULL)
+    {
+        return cache->data;
+    }
+
+    ticks = drv_get_current_time();
+    if( entry->format == BUNDLE_SPANS565)
+    {
+        cache->data = blob;
     }
     else
     {
-        gui_BLT_double_buffer(0, 0, UI_device_width - 1, UI_device_height - 1);
+        // an entry with the same blob may have expanded it already
+        for( i = 0; i < TETRIS_ASSET_COUNT && cache->data == NULL; i ++)
+        {
+            if( tetris_bundle_cache[i].decoded != NULL && tetris_bundle_index[i].offset == entry->offset)
+            {
+                cache->data = tetris_bundle_cache[i].decoded;
+            }
+        }
+    }
+    if( cache->data == NULL)
+    {
+        spanBytes = blob[0] | ( blob[1] << 8);
+        colors  = blob[2] + 1;
+        palette = (const U16 *)( blob + 4);
+        pixels  = entry->size - 4 - colors * 2 - spanBytes;
+
+        cache->decoded = TETRIS_ALLOC( 2 + spanBytes + ( spanBytes & 1) + pixels * 2);
+        if( cache->decoded == NULL)
+        {
+            return NULL;
+        }
+        memcpy( cache->decoded, blob, 2);
+        memcpy( cache->decoded + 2, blob + 4 + colors * 2, spanBytes);
+        pixel = (U16 *)( cache->decoded + 2 + spanBytes + ( spanBytes & 1));
+        blob += 4 + colors * 2 + spanBytes;
+        for( i = 0; i < pixels; i ++)
+        {
+            pixel[i] = palette[blob[i]];
+        }
+        cache->data   = cache->decoded;
+        cache->ramBytes = 2 + spanBytes + ( spanBytes & 1) + pixels * 2;
+    }
+    if( cache->firstUseUs == 0)
+    {
+        cache->firstUseUs = ( drv_get_current_time() - ticks) * 15625 / 512 + 1;
+    }
+    return cache->data;
+}
+
+// Frees what was expanded, the counters are kept for bundleReport.
+static void releaseTheBundle( void)
+{
+
+    int i;
+
+    for( i = 0; i < TETRIS_ASSET_COUNT; i ++)
+    {
+        if( tetris_bundle_cache[i].decoded != NULL)
+        {
+            TETRIS_FREE( tetris_bundle_cache[i].decoded);
+        }
+        tetris_bundle_cache[i].decoded = NULL;
+        tetris_bundle_cache[i].data    = NULL;
+    }
+}
+
+#ifdef __TETRIS_BUNDLE_REPORT__
+static void bundleReport( void)
+{
+
+    const CBundleEntry  *entry;
+    CBundleCache        *cache;
+    int                 i;
+
+    debug( ";bundle: %d entries, %d bytes", TETRIS_ASSET_COUNT, (int)sizeof( tetris_bundle));
+    for( i = 0; i < TETRIS_ASSET_COUNT; i ++)
+    {
+        entry = &tetris_bundle_index[i];
+        cache = &tetris_bundle_cache[i];
+        debug( ";  %2d: format %d, rom %4d, ram %5d, uses %6d, first use %6d us",
+                i, entry->format, entry->size, cache->ramBytes, cache->uses, cache->firstUseUs);
+    }
+}
+#endif
+
+// Copies the opaque spans of a bundle image into the active layer, the PNG
+// is decoded instead only if the layer is not 16 bit or the image is clipped.
+static void drawBundleImage( U8 index, int16 x, int16 y)
+{
+
+    const CBundleEntry  *image  = &tetris_bundle_index[index];
+    const U8            *data   = NULL;
+    const U8            *span   = NULL;
+    const U16           *pixel  = NULL;
+    U8                  *buffer = NULL;
+    U16                 *line   = NULL;
+    S32                 layerWidth  = 0;
+    S32                 layerHeight = 0;
+    int                 row     = 0;
+    int                 count   = 0;
+
+    gdi_layer_get_buffer_ptr( &buffer);
+    gdi_layer_get_dimension( &layerWidth, &layerHeight);
+    if( gdi_layer_get_bit_per_pixel() != 16 || buffer == NULL ||
+        x < 0 || y < 0 || x + image->width > layerWidth || y + image->height > layerHeight ||
+        ( data = loadBundleEntry( index)) == NULL)
+    {
+        showTransparentImage( x, y, (PU8)get_image( image->imageId), 0);
+        return;
+    }
+
+    span  = data + 2;
+    count = data[0] | ( data[1] << 8);
+    pixel = (const U16 *)( span + count + ( count & 1));
+
+    markTheDamagedArea( x, y, x + image->width - 1, y + image->height - 1);
+    RENDER_COUNT( blits, image->width, image->height);
+    for( row = 0; row < image->height; row ++)
+    {
+        line = (U16 *)buffer + ( y + row) * layerWidth + x;
+        for( count = *span ++; count > 0; count --)
+        {
+            line += span[0];
+            memcpy( line, pixel, span[1] * sizeof( U16));
+            line  += span[1];
+            pixel += span[1];
+            span  += 2;
+        }
+    }
+}
+
+// Blits what was drawn since the last present, and nothing if nothing was.
+static void presentTheScreen( void)
+{
+
+    TetRect *area = &me->damagedArea;
+
+    if( area->dx == 0)
+    {
+        return;
+    }
+
+    TRACE2( TRACE_PRESENT, area->dx, area->dy);
+#ifdef __TETRIS_RENDER_COUNT__
+    tetris_render_count.presents ++;
+    tetris_render_count.presented += (U32)area->dx * area->dy;
+#endif
+#ifdef __TETRIS_GOLDEN__
+    if( g_gx_tetris_golden.active)
+    {
+        SETAEERECT( area, 0, 0, 0, 0);
+        goldenFrame();
+        return;
+    }
+#endif
+#ifdef __TETRIS_BENCHMARK__
+    if( tetris_bench_offscreen)
+    {
+        SETAEERECT( area, 0, 0, 0, 0);
+        return;
+    }
+#endif
+#ifdef __TETRIS_VIRTUAL_CLOCK__
+    if( tetris_headless)
+    {
+        SETAEERECT( area, 0, 0, 0, 0);
+        return;
+    }
+#endif
+    gui_BLT_double_buffer( area->x, area->y, area->x + area->dx - 1, area->y + area->dy - 1);
+    SETAEERECT( area, 0, 0, 0, 0);
+    LATENCY_PRESENTED();
+#ifdef __TETRIS_RENDER_COUNT__
+    if( tetris_render_count.frameStart != 0)
+    {
+        tetris_render_count.frameTicks += drv_get_current_time() - tetris_render_count.frameStart;
+        tetris_render_count.frameStart  = 0;
     }
+#endif
+}
+
+static void drawGridCell( int16 x, int16 y, color cellColor)
+{
+
+    TetRect rect;
+
+    rect.x  = x;
+    rect.y  = y;
+    rect.dx = me->gridSideLength - 1;
+    rect.dy = me->gridSideLength - 1;
+
+    fillRectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,cellColor);
 }
 
 static void drawTetris( CTetris *tetris, boolean bOverDraw)
@@ -1423,7 +5150,6 @@ static void drawTetris( CTetris *tetris, boolean bOverDraw)
 
     int     i = 0;
     RGBVAL  color;
-    TetRect rect;
 
     if (bOverDraw)
     {
@@ -1440,107 +5166,482 @@ static void drawTetris( CTetris *tetris, boolean bOverDraw)
     for( i = 0; i < 4; i ++)
     {
 
-        rect.x  = tetris->block[i].x;
-        rect.y  = tetris->block[i].y;
-        rect.dx = me->gridSideLength - 1;
-        rect.dy = me->gridSideLength - 1;
+        drawGridCell( tetris->block[i].x, tetris->block[i].y, gui_color(color.r,color.g,color.b));
+    }
+}
+
+static boolean theTetrisCoversTheBlock( CTetris *tetris, CBlock *block)
+{
+
+    int i = 0;
+
+    for( i = 0; i < 4; i ++)
+    {
+        if( tetris->block[i].x == block->x && tetris->block[i].y == block->y)
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+static color getTheGhostColor( uint8 model)
+{
+
+    return gui_color( COLOR_PALETTE[model].r >> GHOST_COLOR_SHIFT,
+                      COLOR_PALETTE[model].g >> GHOST_COLOR_SHIFT,
+                      COLOR_PALETTE[model].b >> GHOST_COLOR_SHIFT);
+}
+
+// Moves the ghost after the falling tetris. Only the blocks which left the
+// old landing position or arrived at the new one are drawn, blocks covered by
+// the falling tetris are left to clearTheFallingTetris.
+static void drawTheGhostTetris( void)
+{
+
+    int     i           = 0;
+    CTetris previous;
+    CGhost  *ghost      = &me->theGhost;
+    boolean wasDrawn    = ghost->drawn;
+
+    if( me->theFallingTetris.pinned)
+    {
+        return;
+    }
+
+    memcpy( &previous, &ghost->tetris, sizeof( previous));
+    if( !calculateTheGhostTetris() && wasDrawn)
+    {
+        return;
+    }
+
+    for( i = 0; wasDrawn && i < 4; i ++)
+    {
+        if( !theTetrisCoversTheBlock( &ghost->tetris, &previous.block[i]) &&
+            !theTetrisCoversTheBlock( &me->theFallingTetris, &previous.block[i])
+        )
+        {
+            drawGridCell( previous.block[i].x, previous.block[i].y, COLOR_BACKGROUND);
+        }
+    }
+    for( i = 0; i < 4; i ++)
+    {
+        if( ( !wasDrawn || !theTetrisCoversTheBlock( &previous, &ghost->tetris.block[i])) &&
+            !theTetrisCoversTheBlock( &me->theFallingTetris, &ghost->tetris.block[i])
+        )
+        {
+            drawGridCell( ghost->tetris.block[i].x, ghost->tetris.block[i].y,
+                    getTheGhostColor( ghost->tetris.model));
+        }
+    }
+    ghost->drawn = TRUE;
+} // drawTheGhostTetris
+
+// Repaints the grids under the tetris from the grid matrix.
+static void restoreTheGridsUnderTheTetris( CTetris *tetris)
+{
+
+    int     i   = 0;
+    int     row = 0;
+    int     col = 0;
+    uint8   tetrisModel;
 
-        gui_fill_rectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,
-								  gui_color(color.r,color.g,color.b));
+    for( i = 0; i < 4; i ++)
+    {
+        row = ( tetris->block[i].y - me->playingZone.y) / me->gridSideLength;
+        col = ( tetris->block[i].x - me->playingZone.x) / me->gridSideLength;
+        tetrisModel = me->gridMatrix[row][col].tetrisModel;
+
+        drawGridCell( tetris->block[i].x, tetris->block[i].y,
+                me->gridMatrix[row][col].dirty ?
+                gui_color( COLOR_PALETTE[tetrisModel].r, COLOR_PALETTE[tetrisModel].g,
+                           COLOR_PALETTE[tetrisModel].b) :
+                COLOR_BACKGROUND);
     }
+}
+
+static void eraseTheGhostTetris( void)
+{
 
-    gui_BLT_double_buffer(0, 0, UI_device_width - 1, UI_device_height - 1);
+    if( me->theGhost.drawn)
+    {
+        restoreTheGridsUnderTheTetris( &me->theGhost.tetris);
+        me->theGhost.drawn = FALSE;
+    }
 }
 
 static void drawTheFallingTetris( void)
 {
 
+    drawTheGhostTetris();
     drawTetris( &me->theFallingTetris, FALSE);
+    presentTheScreen();
 }
 
 static void clearTheFallingTetris( void)
 {
 
-    drawTetris( &me->theFallingTetris, TRUE);
-}
+    int     i       = 0;
+    CBlock  *block  = NULL;
+
+    // the ghost shows through where the falling tetris overlapped it
+    for( i = 0; i < 4; i ++)
+    {
+        block = &me->theFallingTetris.block[i];
+        drawGridCell( block->x, block->y,
+                ( me->theGhost.drawn && theTetrisCoversTheBlock( &me->theGhost.tetris, block)) ?
+                getTheGhostColor( me->theGhost.tetris.model) : COLOR_BACKGROUND);
+    }
+}
+
+static void drawTheNextFallingTetris( void)
+{
+
+    drawTetris( &me->theNextFallingTetris, FALSE);
+    presentTheScreen();
+}
+
+static void clearTheNextFallingTetris( void)
+{
+
+    drawTetris( &me->theNextFallingTetris, TRUE);
+}
+
+static boolean playMusic( MusicTypeEnum type)
+{
+	TRACE2( TRACE_SOUND_REQUEST, type, g_gx_tetris_context.soundOn);
+	if( type == MUSIC_TITLE)
+	{
+		/* the splash comes before the framework menu, take the setting from the cache */
+		if (tetris_config_loaded == FALSE)
+			loadSettingData();
+		g_gx_tetris_context.soundOn = g_gx_tetris_context.configData.soundOn;
+	}
+	if( g_gx_tetris_context.soundOn == FALSE)
+	{
+		return FALSE;
+	}
+	if( type >= MUSIC_NUMBER)
+	{
+		return FALSE;
+	}
+
+	/* requests of one frame are merged, the strongest one is played */
+	if( tetris_sound_pending == MUSIC_NUMBER
+		|| tetris_sound_priority[type] > tetris_sound_priority[tetris_sound_pending])
+	{
+		tetris_sound_pending = type;
+	}
+	requestTheAudio();
+    return TRUE;
+} // playMusic
 
-static void drawTheNextFallingTetris( void)
+/* gameplay only leaves requests, the device is touched once a frame from the timer */
+static void requestTheAudio( void)
 {
-
-    drawTetris( &me->theNextFallingTetris, FALSE);
+	if( tetris_audio_armed == FALSE)
+	{
+		tetris_audio_armed = TRUE;
+		gui_start_timer( SOUND_FRAME_TIME, serviceTheAudio);
+	}
 }
 
-static void clearTheNextFallingTetris( void)
+static void serviceTheAudio( void)
 {
-
-    drawTetris( &me->theNextFallingTetris, TRUE);
+	tetris_audio_armed = FALSE;
+	flushTheSound();
+	serviceTheBackgroundMusic();
 }
 
-static boolean playMusic( MusicTypeEnum type)
+static void flushTheSound( void)
 {
-	U8* buffer;
+	const U8* buffer;
 	U32 size;
-	debug("sound=====%d",g_gx_tetris_context.soundOn);
-	if( type == MUSIC_TITLE)
+	U8 format = MDI_FORMAT_SMF;
+#ifdef __TETRIS_TONE_RENDERER__
+	const CToneEvent *tones = NULL;
+	U16 toneCount = 0;
+	U32 waveSize;
+#endif
+	MusicTypeEnum type = tetris_sound_pending;
+	mdi_result result = MDI_AUDIO_FAIL;
+
+	tetris_sound_pending = MUSIC_NUMBER;
+	if( type == MUSIC_NUMBER || g_gx_tetris_context.soundOn == FALSE)
 	{
-		S16 error;
-	#ifdef __MMI_GAME_MULTICHANNEL_SOUND__
-		ReadValue(NVRAM_GFX_SOUND_EFFECT_SETTING, &g_gx_tetris_context.soundOn, DS_BYTE, &error);
-	#else /* __MMI_GAME_MULTICHANNEL_SOUND__ */ 
-		ReadValue(NVRAM_GFX_AUDIO_SETTING, &g_gx_tetris_context.soundOn, DS_BYTE, &error);
-	#endif
-		if (error != NVRAM_READ_SUCCESS)
-			return FALSE;
+		return;
 	}
-	if( g_gx_tetris_context.soundOn == FALSE)
+
+	if( tetris_sound_playing != MUSIC_NUMBER
+		&& drv_get_current_time() - tetris_sound_start > SOUND_HOLD_TIME * 32768 / 1000)
 	{
-		return FALSE;
+		tetris_sound_playing = MUSIC_NUMBER; // the end callback got lost
 	}
-
+	if( tetris_sound_playing != MUSIC_NUMBER
+		&& ( type == tetris_sound_playing
+			|| tetris_sound_priority[type] < tetris_sound_priority[tetris_sound_playing]))
+	{
+		TRACE1( TRACE_SOUND_DROPPED, type, tetris_sound_playing);
+		return;
+	}
+#ifndef __MMI_GAME_MULTICHANNEL_SOUND__
+	/* one player: only the rare effects cut the loop, it starts again after them */
+	if( tetris_bgm_state == BGM_PLAYING
+		&& type != MUSIC_NEXTSPEED && type != MUSIC_NEXTLEVEL && type != MUSIC_GAMEOVER)
+	{
+		TRACE1( TRACE_SOUND_DROPPED, type, MUSIC_TITLE);
+		return;
+	}
+#endif
     switch(type)
     {
         case MUSIC_TITLE:
             buffer = tetris_sfx_title;
 			size = tetris_sfx_title_size;
+			TONE_SELECT(tetris_tone_title);
             break;
 
         case MUSIC_PLACE:
 			buffer = tetris_sfx_blink;
 			size = tetris_sfx_blink_size;
+			TONE_SELECT(tetris_tone_blink);
             break;
 
         case MUSIC_SINLINE:
             buffer = tetris_sfx_singleline;
 			size = tetris_sfx_singleline_size;
+			TONE_SELECT(tetris_tone_singleline);
             break;
 
         case MUSIC_MULLINES:
             buffer = tetris_sfx_mullines;
 			size = tetris_sfx_mullines_size;
+			TONE_SELECT(tetris_tone_mullines);
             break;
 
         case MUSIC_NEXTSPEED:
             buffer = tetris_sfx_hero;
 			size = tetris_sfx_hero_size;
+			TONE_SELECT(tetris_tone_hero);
             break;
 
         case MUSIC_NEXTLEVEL:
             buffer = tetris_sfx_success;
 			size = tetris_sfx_success_size;
+			TONE_SELECT(tetris_tone_success);
             break;
 
         case MUSIC_GAMEOVER:
             buffer = tetris_sfx_fail;
 			size = tetris_sfx_fail_size;
+			TONE_SELECT(tetris_tone_fail);
             break;
 
         default:
-            return FALSE;
+            return;
     }
-	debug("play sound");
-    GFX_TETRIS_PLAY_AUDIO(buffer, size, DEVICE_AUDIO_PLAY_ONCE);
-    return TRUE;
-} // playMusic
+#ifdef __TETRIS_TONE_RENDERER__
+	/* no SMF parse on the device, the driver only streams PCM */
+	waveSize = renderTheTones( tones, toneCount, &buffer);
+	if( waveSize != 0)
+	{
+		size   = waveSize;
+		format = MDI_FORMAT_WAV;
+	}
+#endif
+	tetris_sound_ticket++;
+    GFX_TETRIS_PLAY_AUDIO(buffer, size, format, DEVICE_AUDIO_PLAY_ONCE, soundFinished, (void*)tetris_sound_ticket, result);
+	TRACE1( TRACE_SOUND_PLAY, type, result);
+	if( result == MDI_AUDIO_SUCCESS)
+	{
+		tetris_sound_playing = type;
+		tetris_sound_start = drv_get_current_time();
+		if( tetris_bgm_state == BGM_PLAYING)
+		{
+#ifdef __MMI_GAME_MULTICHANNEL_SOUND__
+			mdi_audio_mma_set_volume( tetris_bgm_handle, GFX.aud_volume >> BGM_DUCK_SHIFT);
+			tetris_bgm_state = BGM_DUCKED;
+#else
+			/* a single channel gave the string player to the effect */
+			tetris_bgm_state = BGM_CUT;
+#endif
+		}
+	}
+} // flushTheSound
+
+#ifdef __TETRIS_TONE_RENDERER__
+/*
+** Renders a note list as an 8 bit mono WAV into the next slot of the
+** ring, returns its size or 0 if the effect is left to the SMF path.
+*/
+static U32 renderTheTones( const CToneEvent *tones, U16 count, const U8 **wav)
+{
+	U8 *out;
+	U8 *pcm;
+	U32 samples = 0;
+	U32 i, s, end;
+	U16 phase;
+	int value;
+
+	for( i = 0; i < count; i++)
+	{
+		end = ( U32)( tones[i].start + tones[i].length) * TONE_SAMPLE_RATE / 1000;
+		if( end > samples)
+			samples = end;
+	}
+	if( samples == 0 || samples > TONE_SLOT_SAMPLES)
+	{
+		return 0;
+	}
+
+	/* a repeated effect is still in its slot */
+	for( i = 0; i < TONE_SLOTS; i++)
+	{
+		if( tetris_tone_owner[i] == tones)
+		{
+			*wav = tetris_tone_ring[i];
+			return TONE_WAV_HEADER + samples;
+		}
+	}
+
+	tetris_tone_slot = ( tetris_tone_slot + 1) % TONE_SLOTS;
+	tetris_tone_owner[tetris_tone_slot] = tones;
+	out = tetris_tone_ring[tetris_tone_slot];
+	pcm = out + TONE_WAV_HEADER;
+
+	/* RIFF header of a PCM, mono, 8 bit file */
+	memcpy( out, "RIFF", 4);
+	TONE_PUT32( out + 4, 36 + samples);
+	memcpy( out + 8, "WAVEfmt ", 8);
+	TONE_PUT32( out + 16, 16);
+	TONE_PUT32( out + 20, 0x00010001); // PCM, mono
+	TONE_PUT32( out + 24, TONE_SAMPLE_RATE);
+	TONE_PUT32( out + 28, TONE_SAMPLE_RATE);
+	TONE_PUT32( out + 32, 0x00080001); // 1 byte per sample, 8 bits
+	memcpy( out + 36, "data", 4);
+	TONE_PUT32( out + 40, samples);
+
+	/* the notes are mixed on top of each other, clipped */
+	memset( pcm, 0x80, samples);
+	for( i = 0; i < count; i++)
+	{
+		s     = ( U32)tones[i].start * TONE_SAMPLE_RATE / 1000;
+		end   = ( U32)( tones[i].start + tones[i].length) * TONE_SAMPLE_RATE / 1000;
+		phase = 0;
+		for( ; s < end; s++, phase += tones[i].step)
+		{
+			value = pcm[s] + (( phase & 0x8000) ? -tones[i].volume : tones[i].volume);
+			pcm[s] = ( U8)( value < 0 ? 0 : ( value > 255 ? 255 : value));
+		}
+	}
+
+	*wav = out;
+	return TONE_WAV_HEADER + samples;
+} // renderTheTones
+#endif /* __TETRIS_TONE_RENDERER__ */
+
+static void soundFinished( mdi_result result, void *userData)
+{
+	if( (U32)userData != tetris_sound_ticket)
+	{
+		return; // an effect the current one has cut off
+	}
+	tetris_sound_playing = MUSIC_NUMBER;
+	if( tetris_bgm_state == BGM_DUCKED || tetris_bgm_state == BGM_CUT ||
+		( tetris_bgm_wanted && tetris_bgm_state == BGM_STOPPED))
+	{
+		requestTheAudio(); // the loop comes back, or starts if the effect kept it waiting
+	}
+} // soundFinished
+
+/*
+** Brings the loop in line with tetris_bgm_wanted, effects go first. The
+** multichannel loop pauses and resumes where it was. The string player of
+** a single channel cannot resume: only a new speed, a new level or the
+** game over cut the loop, it starts from ROM at its beginning after them,
+** the frequent effects are not played over it.
+*/
+static void serviceTheBackgroundMusic( void)
+{
+	mdi_result result = MDI_AUDIO_FAIL;
+	BOOL wanted = tetris_bgm_wanted && g_gx_tetris_context.soundOn;
+
+	if( wanted == FALSE)
+	{
+#ifdef __MMI_GAME_MULTICHANNEL_SOUND__
+		if( tetris_bgm_state == BGM_PLAYING || tetris_bgm_state == BGM_DUCKED)
+		{
+			mdi_audio_mma_pause( tetris_bgm_handle);
+			tetris_bgm_state = BGM_PAUSED;
+		}
+#else
+		if( tetris_bgm_state == BGM_PLAYING)
+			mdi_audio_stop_string();
+		tetris_bgm_state = BGM_STOPPED;
+#endif
+		return;
+	}
+
+	if( tetris_sound_playing != MUSIC_NUMBER || tetris_bgm_state == BGM_PLAYING)
+	{
+		return; // soundFinished asks again
+	}
+
+#ifdef __MMI_GAME_MULTICHANNEL_SOUND__
+	if( tetris_bgm_state == BGM_DUCKED)
+	{
+		mdi_audio_mma_set_volume( tetris_bgm_handle, GFX.aud_volume);
+		tetris_bgm_state = BGM_PLAYING;
+		return;
+	}
+	if( tetris_bgm_state == BGM_PAUSED)
+	{
+		if( GFX_TETRIS_AUDIO_ALLOWED())
+		{
+			mdi_audio_mma_set_volume( tetris_bgm_handle, GFX.aud_volume);
+			if( mdi_audio_mma_resume( tetris_bgm_handle) == MDI_AUDIO_SUCCESS)
+				tetris_bgm_state = BGM_PLAYING;
+		}
+		return;
+	}
+	if( tetris_bgm_handle == 0)
+	{
+		tetris_bgm_handle = mdi_audio_mma_open_midi( (void*)tetris_sfx_title, tetris_sfx_title_size, 0, NULL);
+	}
+	if( tetris_bgm_handle != 0 && GFX_TETRIS_AUDIO_ALLOWED())
+	{
+		mdi_audio_mma_set_volume( tetris_bgm_handle, GFX.aud_volume);
+		result = mdi_audio_mma_play( tetris_bgm_handle);
+	}
+#else
+	/* stopped or cut, the string player starts the loop from ROM */
+	GFX_TETRIS_PLAY_AUDIO(tetris_sfx_title, tetris_sfx_title_size, MDI_FORMAT_SMF, DEVICE_AUDIO_PLAY_INFINITE, NULL, NULL, result);
+#endif
+	tetris_bgm_state = ( result == MDI_AUDIO_SUCCESS) ? BGM_PLAYING : BGM_STOPPED;
+} // serviceTheBackgroundMusic
+
+/* Drops every request and silences the loop, the game leaves the screen. */
+static void stopTheAudio( void)
+{
+	gui_cancel_timer( serviceTheAudio);
+	tetris_audio_armed   = FALSE;
+	tetris_sound_pending = MUSIC_NUMBER;
+	tetris_sound_playing = MUSIC_NUMBER;
+	tetris_bgm_wanted    = FALSE;
+#ifdef __MMI_GAME_MULTICHANNEL_SOUND__
+	if( tetris_bgm_handle != 0)
+	{
+		mdi_audio_mma_stop( tetris_bgm_handle);
+		mdi_audio_mma_close_midi( tetris_bgm_handle);
+		tetris_bgm_handle = 0;
+	}
+#else
+	if( tetris_bgm_state == BGM_PLAYING)
+		mdi_audio_stop_string();
+#endif
+	tetris_bgm_state = BGM_STOPPED;
+} // stopTheAudio
 
 static void refreshPlayingZoneAfterDeleteDirtyRows( void)
 {
@@ -1550,6 +5651,8 @@ static void refreshPlayingZoneAfterDeleteDirtyRows( void)
     int tetrisModel;
     TetRect rect;
 
+    WATCHDOG_STEP( refreshPlayingZoneAfterDeleteDirtyRows);
+    eraseTheGhostTetris();
     for( i = me->theTopmostRowOfThePinnedTetrises; i <= me->dirtyRowIndex[0]; i++)
     {
         for(j = 0; j < me->gridColumnNumber; j++)
@@ -1559,24 +5662,25 @@ static void refreshPlayingZoneAfterDeleteDirtyRows( void)
             rect.dx = rect.dy = me->gridSideLength - 1;
             if( !me->gridMatrix[i][j].dirty)    // Use background color.
             {
-				gui_fill_rectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,COLOR_BACKGROUND);
+				fillRectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,COLOR_BACKGROUND);
             }
             else                                    // Use color of the block.
             {
                 tetrisModel = me->gridMatrix[i][j].tetrisModel;
-				gui_fill_rectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,
+				fillRectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,
 								  gui_color(COLOR_PALETTE[tetrisModel].r,COLOR_PALETTE[tetrisModel].g,
 								  		    COLOR_PALETTE[tetrisModel].b));
             }
         }
     }
     me->theTopmostRowOfThePinnedTetrises += me->dirtyRowNumber;
-    gui_BLT_double_buffer(0, 0, UI_device_width - 1, UI_device_height - 1);
+    presentTheScreen();
 } // refreshPlayingZoneAfterDeleteDirtyRows
 
 static boolean updateGameScoreAndGoToNextLevelIf( void)
 {
 
+    me->gameLines += me->dirtyRowNumber;
     switch( me->dirtyRowNumber)
     {
         case 1:
@@ -1666,7 +5770,7 @@ static void drawTheFinalTetrisWhichFillupThePlayingZone( int16 yFrowWhereToDrawT
                 continue;
             }
 
-			gui_fill_rectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,
+			fillRectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,
 								  gui_color(COLOR_PALETTE[me->theFallingTetris.model].r,
 								  			COLOR_PALETTE[me->theFallingTetris.model].g,
 								  		    COLOR_PALETTE[me->theFallingTetris.model].b));
@@ -1678,7 +5782,7 @@ static void drawTheFinalTetrisWhichFillupThePlayingZone( int16 yFrowWhereToDrawT
             me->gridMatrix[row][col].tetrisModel = me->theFallingTetris.model;
         }
 
-        gui_BLT_double_buffer(0, 0, UI_device_width - 1, UI_device_height - 1);
+        presentTheScreen();
     }
 } // drawTheFinalTetrisWhichFillupThePlayingZone
 
@@ -1689,6 +5793,9 @@ static void flashWhenDeleteDirtyRows( void)
     color   dcolor;
     TetRect rect;
 
+    HUD_TIMER_FIRED( flashWhenDeleteDirtyRows);
+    REPLAY_TICK();
+    WATCHDOG_ENTER( WATCHDOG_FLASH, flashWhenDeleteDirtyRows);
     if( me->flashCounterWhenDeleteDirtyRows % 2 == 0)
     {
         dcolor = gui_color(205,179,139);
@@ -1707,17 +5814,17 @@ static void flashWhenDeleteDirtyRows( void)
         rect.y = me->dirtyRowIndex[i] * me->gridSideLength + me->playingZone.y;
         for( j = 0; j < me->gridColumnNumber; j++)
         {
-            gui_fill_rectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,dcolor);
+            fillRectangle(rect.x,rect.y,rect.x+rect.dx-1,rect.y+rect.dy-1,dcolor);
             rect.x += me->gridSideLength;
         }
     }
-    gui_BLT_double_buffer(0, 0, UI_device_width - 1, UI_device_height - 1);
+    presentTheScreen();
 
     if(me->flashCounterWhenDeleteDirtyRows < MAX_FLASH_TIMES)
     {
 
         me->flashCounterWhenDeleteDirtyRows += 1;
-        gui_start_timer(FLASH_TIME, flashWhenDeleteDirtyRows);
+        startGameTimer(FLASH_TIME, flashWhenDeleteDirtyRows);
     }
     else
     {
@@ -1728,17 +5835,21 @@ static void flashWhenDeleteDirtyRows( void)
         me->dirtyRowNumber = 0;
         drawTheFallingTetris();
 
-		gui_start_timer(me->sleepTime, moveDownwardsIf);
+		startGameTimer(me->sleepTime, moveDownwardsIf);
     }
+    WATCHDOG_LEAVE();
 } // flashWhenDeleteDirtyRows
 
 static void gameOver( void)
 {
 
+    REPLAY_TICK();
+    WATCHDOG_ENTER( WATCHDOG_GAME_OVER, gameOver);
     setGameState(GAME_STATE_OVER);
 
 	killTimer();
     clearPlayingZoneAfterGameOver();
+    WATCHDOG_LEAVE();
 }
 
 static void clearPlayingZoneAfterGameOver( void)
@@ -1746,6 +5857,8 @@ static void clearPlayingZoneAfterGameOver( void)
 
     int column = 0;
 
+    REPLAY_TICK();
+    WATCHDOG_ENTER( WATCHDOG_GAME_OVER, clearPlayingZoneAfterGameOver);
     if( me->gridToClear.y > me->playingZone.y)
     {
         me->gridToClear.y -= me->gridSideLength;
@@ -1753,19 +5866,21 @@ static void clearPlayingZoneAfterGameOver( void)
     else
     {
         saveGameDataAndDisplayGameScore();
+        WATCHDOG_LEAVE();
         return;
     }
 
     me->gridToClear.x = me->playingZone.x;
     for( column = 0; column < me->gridColumnNumber; column ++)
     {
-		gui_fill_rectangle(me->gridToClear.x,me->gridToClear.y,me->gridToClear.x+me->gridToClear.dx-1,
+		fillRectangle(me->gridToClear.x,me->gridToClear.y,me->gridToClear.x+me->gridToClear.dx-1,
 						   me->gridToClear.y+me->gridToClear.dy-1, gui_color(0, 0xcf, 0xff));
         me->gridToClear.x += me->gridSideLength;
     }
-    gui_BLT_double_buffer(0, 0, UI_device_width - 1, UI_device_height - 1);
+    presentTheScreen();
 
-    gui_start_timer(OVER_TIME, clearPlayingZoneAfterGameOver);
+    startGameTimer(OVER_TIME, clearPlayingZoneAfterGameOver);
+    WATCHDOG_LEAVE();
 }
 
 static void saveGameDataAndDisplayGameScore( void)
@@ -1773,21 +5888,20 @@ static void saveGameDataAndDisplayGameScore( void)
 
     int     gameLevelStartFromZero;
     uint16  baseSpeed;
-    uint16  totalScore;
+    uint32  totalScore;
+    S8      rank;
 
     gameLevelStartFromZero      = g_gx_tetris_context.gameLevel - 1;
     baseSpeed   = (INIT_TIME - (( MAX_LEVEL - gameLevelStartFromZero) * INIT_TIME / MAX_LEVEL)) / TIME_SLICE;
-    totalScore  = (g_gx_tetris_context.gameSpeed - baseSpeed) * LEVEL_SCORE + g_gx_tetris_context.gameScore;
-    if( totalScore > g_gx_tetris_context.configData.topScore[gameLevelStartFromZero])
+    totalScore  = (uint32)(g_gx_tetris_context.gameSpeed - baseSpeed) * LEVEL_SCORE + g_gx_tetris_context.gameScore;
+    REPLAY_SAVE();
+    rank = insertTheScore( gameLevelStartFromZero, totalScore);
+    if( rank >= 0)
     {
-        g_gx_tetris_context.configData.topScore[gameLevelStartFromZero] = totalScore;
         saveSettingData();
-        displayGameScoreScreen( STR_GX_TETRIS_REPORT_RECORD, totalScore, TRUE);
-    }
-    else
-    {
-        displayGameScoreScreen( STR_GX_TETRIS_REPORT_SCORE, totalScore, FALSE);
     }
+    displayGameScoreScreen( rank == 0 ? STR_GX_TETRIS_REPORT_RECORD : STR_GX_TETRIS_REPORT_SCORE,
+            totalScore, rank == 0);
 } // saveGameDataAndDisplayGameScore
 
 static void resetControlsAndClearScreen( boolean clearScreen)
@@ -1795,6 +5909,8 @@ static void resetControlsAndClearScreen( boolean clearScreen)
     if( clearScreen)
     {
 		clear_screen();
+        markTheDamagedArea( 0, 0, UI_device_width - 1, UI_device_height - 1);
+        RENDER_COUNT( fills, g_gx_tetris_context.screenWidth, g_gx_tetris_context.screenHeight);
     }
 } // resetControlsAndClearScreen
 
@@ -1837,111 +5953,38 @@ void displayScreenStop(void)
     /* stop all playing audio and vibration */
     VibratorOff();
     mdi_audio_stop_string();
+    stopTheAudio();
 
     /* resume if there is background playing */
     mdi_audio_resume_background_play();
 
 }
 
-extern void mmi_gfx_enter_game(void);
-extern void mmi_gfx_exit_game(void);
-
-static void gotoNextLevelYesButton(void)
-{
-	S16 error;
-	MMI_BOOL entry_ret = MMI_FALSE;
-	me->gameLevel += 1;
-	//copy of mmi_gfx_enter_game
-	mmi_frm_scrn_close_active_id();
-	entry_ret = mmi_frm_scrn_enter (GFX.cur_gid, GFX_GAME_SCREEN, mmi_gfx_exit_game, mmi_gfx_enter_game, MMI_FRM_FG_ONLY_SCRN);
-	if (!entry_ret)
-	{
-		kal_prompt_trace(MOD_MMI, "Misstion is imposible");
-		return;
-	}
-
-    /* reset clip */
-    gdi_layer_reset_clip();
-    gdi_layer_reset_text_clip();
-
-    /* entry full screen app */
-    entry_full_screen();
-
-    ClearInputEventHandler(MMI_DEVICE_ALL);
-    clear_category_screen_key_handlers();
-
-    SetKeyHandler(mmi_frm_scrn_close_active_id, KEY_RSK, KEY_EVENT_UP);
-    SetKeyHandler(mmi_gfx_volume_up, KEY_VOL_UP, KEY_EVENT_DOWN);
-    SetKeyHandler(mmi_gfx_volume_down, KEY_VOL_DOWN, KEY_EVENT_DOWN);
-
-    /* reset clip */
-    gui_reset_text_clip();
-    gui_reset_clip();
-
-    /* 
-     * This is used to solve a very rare situation. When playing a IMELODY 
-     * with backlight on/off, and the screen previous to this screen is a 
-     * horizontal screen. Before enter this screen, the IMELODY turn off the
-     * backlight. While exit previous screen, the layer rotate back to normal
-     * size and the content is not correct. So when calling TurnOnBacklight, 
-     * LCD is in sleepin state and draw wrong content to LCD.
-     * So we need to clear the buffer first to avoid this situation.
-     */
-    gdi_layer_clear(GDI_COLOR_BLACK);
-
-    /* stop MMI sleep */
-    //TurnOnBacklight(0);
-
-#ifdef __MMI_SUBLCD__
-    /* draw game icon on sublcd */
-    ForceSubLCDScreen(mmi_gfx_entry_sublcd_screen);
-#endif /* __MMI_SUBLCD__ */ 
-    /*
-     * fill background with white color - 
-     * for display smaller game on bigger LCM that will have clear background 
-     */
-    gui_fill_rectangle(0, 0, UI_device_width - 1, UI_device_height - 1, gui_color(255, 255, 255));
-
-    /* lock and blt, this may force full screen region will be blt when enter game */
-    gdi_layer_lock_frame_buffer();
-    gdi_layer_blt_previous(0, 0, UI_device_width - 1, UI_device_height - 1);
-    gdi_layer_unlock_frame_buffer();
-
-    /* disalbe align timer and enter game */
-    UI_disable_alignment_timers();
-#ifdef __MTK_TARGET__
-    mmi_frm_set_key_handle_in_high_frequency(MMI_TRUE);
-#endif 
-
-    MMI_PRINT(MOD_MMI_MEDIA_APP, MMI_MEDIA_TRC_G2_APP, "*---[Tetris.c] Enter game after level screen---*\n",
-                         GetString(GFX.game_data.game_str_id));
-
-    GFX.game_data.enter_game_func_ptr();
-	tetris_nextlevel = FALSE; //back to the original value
-}
-
 static void gotoNextLevel( boolean isLastLevel)
 {
 	uint16  gameLevelStartFromZero;
     uint16  levelInitSpeed;
-    uint16  titleId;
-    uint16  totalScore;
-    uint32  staticProperties;
+    uint32  totalScore;
     WCHAR  formatString[128];
     WCHAR  displayString[128];
-	U8 *guiBuffer;  /* Buffer holding history data */
-	MMI_BOOL entry_ret;
 
+    WATCHDOG_STEP( gotoNextLevel);
     killTimer();
-    resetControlsAndClearScreen( FALSE);
+
+    // the rows were deleted but the flash was cut short
+    if( me->flashCounterWhenDeleteDirtyRows != 0)
+    {
+        refreshPlayingZoneAfterDeleteDirtyRows();
+        me->flashCounterWhenDeleteDirtyRows = 0;
+        me->dirtyRowNumber = 0;
+    }
 
 	gameLevelStartFromZero  = me->gameLevel - 1;
     levelInitSpeed = (INIT_TIME - ( ( MAX_LEVEL - gameLevelStartFromZero) * INIT_TIME / MAX_LEVEL)) / TIME_SLICE;
-    totalScore = (me->gameSpeed - levelInitSpeed) * LEVEL_SCORE;
+    totalScore = (uint32)(me->gameSpeed - levelInitSpeed) * LEVEL_SCORE;
     totalScore += isLastLevel ?g_gx_tetris_context.gameScore : 0;
-    if(g_gx_tetris_context.configData.topScore[gameLevelStartFromZero] < totalScore)
+    if( insertTheScore( gameLevelStartFromZero, totalScore) >= 0)
     {
-       g_gx_tetris_context.configData.topScore[gameLevelStartFromZero] = totalScore;
         saveSettingData();
     }
     mmi_wcscpy(formatString, (WCHAR *) GetString(isLastLevel ? STR_GX_TETRIS_PASS_LAST : STR_GX_TETRIS_PASS));
@@ -1950,49 +5993,8 @@ static void gotoNextLevel( boolean isLastLevel)
 
 	tetris_nextlevel = TRUE;
 
-	entry_full_screen();
-
-	entry_ret = mmi_frm_scrn_enter (GFX.cur_gid, GFX_GAMEOVER_SCREEN, displayScreenStop, displayGameScoreScreen, MMI_FRM_UNKNOW_SCRN);
-	if (!entry_ret)
-	{
-		kal_prompt_trace(MOD_MMI, "Misstion is imposible");
-		return;
-	}
-    guiBuffer = mmi_frm_scrn_get_gui_buf(GFX.cur_gid, GFX_GAMEOVER_SCREEN);
-
-    /* not first time enter */
-    if (guiBuffer != NULL)
-    {
-        GFX.is_first_time_enter_gameover = FALSE;
-    }
-
-    if( isLastLevel)
-    {
-		ShowCategory221Screen(
-			0,
-			0,                                      /* caption */
-			0,
-			0,                          /* LSK */
-			STR_GLOBAL_BACK,
-			IMG_GLOBAL_BACK,                                      /* RSK */
-			GDI_COLOR_WHITE,
-			drawStringBox);
-    }
-    else
-    {
-		ShowCategory221Screen(
-			0,
-			0,                                      /* caption */
-			STR_GLOBAL_YES,
-			IMG_GLOBAL_YES,                          /* LSK */
-			STR_GLOBAL_NO,
-			IMG_GLOBAL_NO,                                      /* RSK */
-			GDI_COLOR_WHITE,
-			drawStringBox);
-    }
-	SetLeftSoftkeyFunction(gotoNextLevelYesButton, KEY_EVENT_UP);
-	SetRightSoftkeyFunction(mmi_frm_scrn_close_active_id, KEY_EVENT_UP);
     setGameState(isLastLevel ? GAME_STATE_LASTLEVEL : GAME_STATE_NEXTLEVEL);
+    promptTheLevelIsPassedNow();
 } // gotoNextLevel
 
 static void displayGameScoreScreen( uint16 resourceId, uint32 theScore, boolean recordBroken)
@@ -2002,6 +6004,18 @@ static void displayGameScoreScreen( uint16 resourceId, uint32 theScore, boolean
     U8 *guiBuffer;  /* Buffer holding history data */
 	MMI_BOOL entry_ret;
 
+#ifdef __TETRIS_VIRTUAL_CLOCK__
+    if( g_gx_tetris_clock.on)
+    {
+        // driven by a harness, the report screen is left out
+        g_gx_tetris_context.is_gameover = TRUE;
+        g_gx_tetris_context.is_new_game = TRUE;
+        tetris_ingame = FALSE;
+        tetris_nextlevel = FALSE;
+        setGameState(GAME_STATE_REPORT);
+        return;
+    }
+#endif
     resetControlsAndClearScreen( FALSE);
 
 	mmi_wcscpy(scoreFormatString, (WCHAR *) GetString(resourceId));
@@ -2013,9 +6027,11 @@ static void displayGameScoreScreen( uint16 resourceId, uint32 theScore, boolean
     else
     {
 		mmi_wsprintf_ex(scoreString, sizeof(scoreString), scoreFormatString, theScore,
-						g_gx_tetris_context.configData.topScore[g_gx_tetris_context.gameLevel - 1]);
+						g_gx_tetris_context.configData.leaderboard[g_gx_tetris_context.gameLevel - 1][0].score);
     }
 	mmi_wcscpy(drawee_string, scoreString);
+	formatTheLeaderboard(g_gx_tetris_context.gameLevel - 1, drawee_string,
+						 sizeof(drawee_string) / sizeof(WCHAR));
     entry_full_screen();
 	g_gx_tetris_context.is_gameover = TRUE;
     g_gx_tetris_context.is_new_game = TRUE;
@@ -2069,77 +6085,232 @@ void mmi_gfx_entry_menu_screen_tetris(void)
 		gui_cancel_timer(mmi_gfx_entry_menu_screen_tetris);
 		mmi_gx_tetris_showonce_timer_stop = FALSE;
 	}
+	releaseTheBundle(); /* the splash is not shown again */
+	setGameState(GAME_STATE_MAIN_MENU); /* nothing ticks in the menus */
 	mmi_gfx_entry_menu_screen();
 }
 
-static void getSettingData(void)
+static U16 checksumOfSettingRecord( CTetrisRecord *record)
+{
+	U8 *data = (U8 *)record;
+	U16 sum1 = 0;
+	U16 sum2 = 0;
+	U32 i;
+
+	/* the checksum is followed by padding, stop in front of it */
+	for (i = 0; i < (U32)((U8 *)&record->checksum - data); i++)
+	{
+		sum1 = (sum1 + data[i]) % 255;
+		sum2 = (sum2 + sum1) % 255;
+	}
+	return (sum2 << 8) | sum1;
+}
+
+/* Reads the settings from NVRAM, once per session. */
+static void loadSettingData(void)
 {
 	S16 error;
-	int i;
+	CPrefData *config = &g_gx_tetris_context.configData;
+	CTetrisRecord record;
+
+	tetris_config_loaded = TRUE;
+	tetris_config_dirty = 0;
+
+	/* the sound setting belongs to the framework */
 #ifdef __MMI_GAME_MULTICHANNEL_SOUND__
-	ReadValue(NVRAM_GFX_SOUND_EFFECT_SETTING, &me->configData.soundOn, DS_BYTE, &error);
+	ReadValue(NVRAM_GFX_SOUND_EFFECT_SETTING, &config->soundOn, DS_BYTE, &error);
 #else /* __MMI_GAME_MULTICHANNEL_SOUND__ */ 
-    ReadValue(NVRAM_GFX_AUDIO_SETTING, &me->configData.soundOn, DS_BYTE, &error);
+    ReadValue(NVRAM_GFX_AUDIO_SETTING, &config->soundOn, DS_BYTE, &error);
 #endif
 	if (error != NVRAM_READ_SUCCESS)
-		goto PrefReset;
+		config->soundOn = FALSE;
+
+	ReadRecord(NVRAM_EF_GX_TETRIS_DATA_LID, 1, &record, sizeof(record), &error);
+	if (error == NVRAM_READ_SUCCESS &&
+		record.version == TETRIS_RECORD_VERSION &&
+		record.checksum == checksumOfSettingRecord(&record) &&
+		record.gameLevel >= 1 && record.gameLevel <= MAX_LEVEL)
+	{
+		config->gameLevel = record.gameLevel;
+		config->drawGridLines = record.drawGridLines;
+		memcpy(config->leaderboard, record.leaderboard, sizeof(config->leaderboard));
+	}
+	else
+	{
+		/* first run of this version, take over the old records */
+		debug(";settings record missing or invalid, migrating");
+		loadLegacySettingData();
+		tetris_config_dirty |= CONFIG_DIRTY_RECORD;
+	}
+
+	/* the framework menu changes the level through this one */
+	dummy_gamelevel_val = config->gameLevel - 1;
+}
+
+/* The level byte and the grade shorts used before CTetrisRecord, a grade
+   becomes the first line of its leaderboard. */
+static boolean loadLegacySettingData(void)
+{
+	S16 error;
+	int i;
+	U16 grade;
+	CPrefData *config = &g_gx_tetris_context.configData;
+
+	memset(config->leaderboard, 0, sizeof(config->leaderboard));
 
-	ReadValue(NVRAM_GAME_TETRIS_LEVEL, &me->configData.gameLevel, DS_BYTE, &error);
+	ReadValue(NVRAM_GAME_TETRIS_LEVEL, &config->gameLevel, DS_BYTE, &error);
 	if (error != NVRAM_READ_SUCCESS)
 		goto PrefReset;
 
-	me->configData.gameLevel++;
-	me->configData.drawGridLines = TRUE;
+	config->gameLevel++;
+	config->drawGridLines = TRUE;
 	
-	ReadValue(NVRAM_GX_TETRIS_SCORE_EASY, &me->configData.topScore[0], DS_SHORT, &error);
-	if (error != NVRAM_READ_SUCCESS)
-		goto PrefReset;
-	ReadValue(NVRAM_GX_TETRIS_SCORE_MEDIUM, &me->configData.topScore[1], DS_SHORT, &error);
-	if (error != NVRAM_READ_SUCCESS)
-		goto PrefReset;
-	ReadValue(NVRAM_GX_TETRIS_SCORE_HARD, &me->configData.topScore[2], DS_SHORT, &error);
-	if (error != NVRAM_READ_SUCCESS)
-		goto PrefReset;
+	for (i = 0; i < MAX_LEVEL; i++)
+	{
+		ReadValue(tetris_grade_nvram_id[i], &grade, DS_SHORT, &error);
+		if (error != NVRAM_READ_SUCCESS)
+			goto PrefReset;
+		config->leaderboard[i][0].score = grade;
+	}
 
-	goto End;
+	return TRUE;
 
 PrefReset:
-    me->configData.gameLevel        = 1;
-    me->configData.drawGridLines    = FALSE;
-    me->configData.soundOn      	= FALSE;
+    config->gameLevel        = 1;
+    config->drawGridLines    = FALSE;
+    memset(config->leaderboard, 0, sizeof(config->leaderboard));
+	return FALSE;
+}
 
-    for( i = 0; i < MAX_LEVEL; i ++)
-    {
-        me->configData.topScore[i] = 0;
-    }
+/* No NVRAM I/O: the framework keeps its copy of the level and the sound
+   setting in RAM while its menu changes them. */
+static void getSettingData(void)
+{
+	if (tetris_config_loaded == FALSE)
+		loadSettingData();
 
-End:
-	return;
+	/* the framework wrote its own level slot already, only the record is behind */
+	if (me->configData.gameLevel != dummy_gamelevel_val + 1)
+	{
+		me->configData.gameLevel = dummy_gamelevel_val + 1;
+		tetris_config_dirty |= CONFIG_DIRTY_RECORD;
+	}
+	me->configData.soundOn   = GFX.is_aud_on;
 }
 
+/* Takes the settings of the game into configData, no NVRAM I/O. */
 static void saveSettingData( void)
+{
+	CPrefData *config = &g_gx_tetris_context.configData;
+
+	if (config->gameLevel != g_gx_tetris_context.gameLevel)
+	{
+		config->gameLevel = g_gx_tetris_context.gameLevel;
+		tetris_config_dirty |= CONFIG_DIRTY_LEVEL;
+	}
+	if (config->drawGridLines != g_gx_tetris_context.drawGridLines)
+	{
+		config->drawGridLines = g_gx_tetris_context.drawGridLines;
+		tetris_config_dirty |= CONFIG_DIRTY_GRID;
+	}
+    config->soundOn = g_gx_tetris_context.soundOn;
+	dummy_gamelevel_val = config->gameLevel - 1;
+}
+
+/* Puts the score of the game that just ended into the sorted leaderboard of
+   its level in one pass from the bottom, returns its rank or -1 if it did
+   not make it. An equal score ranks below the older one. */
+static S8 insertTheScore( int levelIndex, U32 score)
+{
+	CScoreEntry *board = g_gx_tetris_context.configData.leaderboard[levelIndex];
+	applib_time_struct now;
+	int i = TETRIS_BOARD_SIZE - 1;
+
+	if (score == 0 || score <= board[i].score)
+		return -1;
+
+	for (; i > 0 && board[i - 1].score < score; i--)
+	{
+		board[i] = board[i - 1];
+	}
+
+	applib_dt_get_rtc_time(&now);
+	board[i].score = score;
+	board[i].lines = g_gx_tetris_context.gameLines;
+	board[i].speed = g_gx_tetris_context.gameSpeed;
+	board[i].timestamp = applib_dt_mytime_2_utc_sec(&now, MMI_FALSE);
+
+	tetris_config_dirty |= (i == 0) ? CONFIG_DIRTY_SCORE(levelIndex) : CONFIG_DIRTY_RECORD;
+	return (S8)i;
+}
+
+/* Appends the leaderboard of a level to text, as many lines as fit. */
+static void formatTheLeaderboard( int levelIndex, WCHAR *text, int size)
+{
+	CScoreEntry *board = g_gx_tetris_context.configData.leaderboard[levelIndex];
+	S8 line[48];
+	WCHAR wline[48];
+	int length = mmi_wcslen(text);
+	int i;
+
+	for (i = 0; i < TETRIS_BOARD_SIZE && board[i].score != 0; i++)
+	{
+		sprintf(line, "\n%d. %lu (%u/%u)", i + 1, (unsigned long)board[i].score,
+				board[i].lines, board[i].speed);
+		mmi_asc_to_ucs2((CHAR *)wline, line);
+		if (length + mmi_wcslen(wline) >= size)
+			break;
+		mmi_wcscpy(text + length, wline);
+		length += mmi_wcslen(wline);
+	}
+}
+
+/* Writes configData if anything changed, called when the game is idle and
+   when the game screen is left. */
+static void flushSettingData( void)
 {
 	S16 error;
+	int i;
 	U8 level_store;
+	U16 grade;
+	CPrefData *config = &g_gx_tetris_context.configData;
+	CTetrisRecord record;
 
-    g_gx_tetris_context.configData.gameLevel        = g_gx_tetris_context.gameLevel;
-    g_gx_tetris_context.configData.drawGridLines    = g_gx_tetris_context.drawGridLines;
-    g_gx_tetris_context.configData.soundOn          = g_gx_tetris_context.soundOn;
-	
-	level_store = g_gx_tetris_context.configData.gameLevel-1;
-	WriteValue(NVRAM_GAME_TETRIS_LEVEL, &level_store, DS_BYTE, &error);
-	if (error != NVRAM_WRITE_SUCCESS)
-		return;
-	
-	WriteValue(NVRAM_GX_TETRIS_SCORE_EASY, &g_gx_tetris_context.configData.topScore[0], DS_SHORT, &error);
-	if (error != NVRAM_WRITE_SUCCESS)
-		return;
-	WriteValue(NVRAM_GX_TETRIS_SCORE_MEDIUM, &g_gx_tetris_context.configData.topScore[1], DS_SHORT, &error);
-	if (error != NVRAM_WRITE_SUCCESS)
+	gui_cancel_timer(flushSettingData);
+	if (tetris_config_dirty == 0)
 		return;
-	WriteValue(NVRAM_GX_TETRIS_SCORE_HARD, &g_gx_tetris_context.configData.topScore[2], DS_SHORT, &error);
+#ifdef __TETRIS_VIRTUAL_CLOCK__
+	if (g_gx_tetris_clock.on)
+		return; /* the harness puts back the settings it found */
+#endif
+
+	memset(&record, 0, sizeof(record));
+	record.version = TETRIS_RECORD_VERSION;
+	record.gameLevel = config->gameLevel;
+	record.drawGridLines = (U8)config->drawGridLines;
+	memcpy(record.leaderboard, config->leaderboard, sizeof(record.leaderboard));
+	record.checksum = checksumOfSettingRecord(&record);
+
+	WriteRecord(NVRAM_EF_GX_TETRIS_DATA_LID, 1, &record, sizeof(record), &error);
 	if (error != NVRAM_WRITE_SUCCESS)
-		return;
+		return; /* still dirty, tried again at the next flush */
+
+	/* keep the framework menu in step, only for what changed */
+	if (tetris_config_dirty & CONFIG_DIRTY_LEVEL)
+	{
+		level_store = config->gameLevel - 1;
+		WriteValue(NVRAM_GAME_TETRIS_LEVEL, &level_store, DS_BYTE, &error);
+	}
+	for (i = 0; i < MAX_LEVEL; i++)
+	{
+		if (tetris_config_dirty & CONFIG_DIRTY_SCORE(i))
+		{
+			/* the framework shows the grade as a signed short */
+			grade = config->leaderboard[i][0].score > 0x7fff ? 0x7fff : (U16)config->leaderboard[i][0].score;
+			WriteValue(tetris_grade_nvram_id[i], &grade, DS_SHORT, &error);
+		}
+	}
+	tetris_config_dirty = 0;
 }
 
 /*
@@ -2212,8 +6383,11 @@ void mmi_gx_tetris_enter_gfx(void)
     GFX.game_data.is_keypad_audio_enable = FALSE;   /* play keypad tone or not */
 	mmi_gx_tetris_showonce_timer_stop = TRUE;
 
+	/* new session, settings are read once here */
+	loadSettingData();
+	setGameState(GAME_STATE_SPLASH);
 	displaySplashScreen();
-    gui_start_timer(INIT_TIME, mmi_gfx_entry_menu_screen_tetris);
+    startGameTimer(INIT_TIME, mmi_gfx_entry_menu_screen_tetris); /* the only tick of the splash */
 }
 
 /*
@@ -2267,6 +6441,11 @@ void mmi_gx_tetris_enter_game(void)
     SetKeyHandler(Tetris_6Key, KEY_RIGHT_ARROW, KEY_EVENT_DOWN);
     SetKeyHandler(Tetris_8Key, KEY_DOWN_ARROW, KEY_EVENT_DOWN);
 	register_keyboard_key_handler(Tetris_KeyboardKey);
+#ifdef __TETRIS_PERF_HUD__
+    SetKeyHandler(Tetris_0Key, KEY_0, KEY_EVENT_DOWN);
+    if (g_gx_tetris_hud.on)
+        gui_start_timer(HUD_PERIOD, hudUpdate);
+#endif
 
     /* start game loop */
     if (g_gx_tetris_context.is_gameover == FALSE)
@@ -2276,11 +6455,17 @@ void mmi_gx_tetris_enter_game(void)
 			g_gx_tetris_context.is_new_game = FALSE;
 			startOneNewGame();
 		}
+		else if (me == NULL && resumeTheGame() == FALSE)
+		{
+			/* the snapshot could not be restored, start over */
+			mmi_gx_tetris_init_game();
+			startOneNewGame();
+		}
 		else
 		{
-			if (tetris_nextlevel == TRUE)
-				me->gameLevel += 1;
-            setGameState(GAME_STATE_RUNNING);
+			/* the level prompt is shown again until it is answered */
+			if (tetris_nextlevel == FALSE)
+				setGameState(GAME_STATE_RUNNING);
             redrawTheScreen();
 		}
     }
@@ -2319,9 +6504,34 @@ void mmi_gx_tetris_exit_game(void)
     /*----------------------------------------------------------------*/
     /* Code Body                                                      */
     /*----------------------------------------------------------------*/
+	killTimer();
+	gui_cancel_timer(mmi_gfx_entry_menu_screen_tetris); /* leaving during the splash */
+	stopTheAudio();
+#ifdef __TETRIS_PERF_HUD__
+	gui_cancel_timer(hudUpdate);
+#endif
+	REPLAY_SAVE(); /* the board is still there for the last keyframe */
 	if (g_gx_tetris_context.is_new_game == TRUE)
 		freeGameDataMemory();
-	killTimer();
+	else if (me != NULL)
+		suspendTheGame(); /* the screen is redrawn from the snapshot on re-entry */
+	flushSettingData();
+	releaseTheBundle();
+#ifdef __TETRIS_BUNDLE_REPORT__
+	bundleReport();
+#endif
+#ifdef __TETRIS_MEM_ACCOUNT__
+	memoryReport();
+#endif
+#ifdef __TETRIS_LATENCY_TRACE__
+	latencyReport();
+#endif
+#ifdef __TETRIS_WATCHDOG__
+	watchdogReport();
+#endif
+#ifdef __TETRIS_TRACE_EXPORT__
+	traceExport();
+#endif
 }
 
 /*
@@ -2350,9 +6560,11 @@ void mmi_gx_tetris_exit_game(void)
 
 void mmi_gx_tetris_init_game(void)
 {
-	if (tetris_ingame == FALSE)
+	/* a new game drops a suspended one */
+	tetris_snapshot_size = 0;
+	if (me == NULL)
 	{
-		if (initGameDataMemory() == TRUE)
+		if (initGameDataMemory(UI_device_width, UI_device_height) == TRUE)
 			debug( ";Tetris_InitAppData success");
 		else
 			freeGameDataMemory();
@@ -0,0 +1,356 @@
+/*
+** Generated by GameImages/img2bundle.py from Game.res, do not edit.
+**
+** 14 entries, 14 blobs, 4862 bundle bytes.
+*/
+
+#ifndef _GAME_TETRIS_BUNDLE_H_
+#define _GAME_TETRIS_BUNDLE_H_
+
+typedef enum
+{
+    TETRIS_ASSET_SPLASH,
+    TETRIS_ASSET_DIGIT_0,
+    TETRIS_ASSET_DIGIT_1,
+    TETRIS_ASSET_DIGIT_2,
+    TETRIS_ASSET_DIGIT_3,
+    TETRIS_ASSET_DIGIT_4,
+    TETRIS_ASSET_DIGIT_5,
+    TETRIS_ASSET_DIGIT_6,
+    TETRIS_ASSET_DIGIT_7,
+    TETRIS_ASSET_DIGIT_8,
+    TETRIS_ASSET_DIGIT_9,
+    TETRIS_ASSET_GAMESCORE_EN,
+    TETRIS_ASSET_GAMESPEED_EN,
+    TETRIS_ASSET_GAMEPAUSE_EN,
+    TETRIS_ASSET_COUNT
+} TetrisAssetEnum;
+
+const CBundleEntry tetris_bundle_index[TETRIS_ASSET_COUNT] =
+{
+    {IMG_ID_GX_TETRIS_SPLASH, 68, 53, BUNDLE_SPANS8, 0, 3947},
+    {IMG_ID_GX_TETRIS_DIGIT_0, 5, 7, BUNDLE_SPANS8, 3948, 51},
+    {IMG_ID_GX_TETRIS_DIGIT_1, 5, 7, BUNDLE_SPANS8, 4000, 35},
+    {IMG_ID_GX_TETRIS_DIGIT_2, 5, 7, BUNDLE_SPANS8, 4036, 41},
+    {IMG_ID_GX_TETRIS_DIGIT_3, 5, 7, BUNDLE_SPANS8, 4078, 42},
+    {IMG_ID_GX_TETRIS_DIGIT_4, 5, 7, BUNDLE_SPANS8, 4120, 45},
+    {IMG_ID_GX_TETRIS_DIGIT_5, 5, 7, BUNDLE_SPANS8, 4166, 45},
+    {IMG_ID_GX_TETRIS_DIGIT_6, 5, 7, BUNDLE_SPANS8, 4212, 50},
+    {IMG_ID_GX_TETRIS_DIGIT_7, 5, 7, BUNDLE_SPANS8, 4262, 37},
+    {IMG_ID_GX_TETRIS_DIGIT_8, 5, 7, BUNDLE_SPANS8, 4300, 49},
+    {IMG_ID_GX_TETRIS_DIGIT_9, 5, 7, BUNDLE_SPANS8, 4350, 50},
+    {IMG_ID_GX_TETRIS_GAMESCORE_EN, 26, 6, BUNDLE_SPANS8, 4400, 125},
+    {IMG_ID_GX_TETRIS_GAMESPEED_EN, 26, 9, BUNDLE_SPANS8, 4526, 155},
+    {IMG_ID_GX_TETRIS_GAMEPAUSE_EN, 29, 7, BUNDLE_SPANS8, 4682, 179},
+};
+
+__align(2)
+const U8 tetris_bundle[4862] =
+{
+    0x9f, 0x00, 0x59, 0x00, 0x4b, 0x00, 0x71, 0x00, 0x95, 0x00, 0xbb, 0x00, 0xdd, 0x00, 0x26, 0x03,
+    0xc9, 0x04, 0x0b, 0x06, 0x7f, 0x06, 0xad, 0x07, 0xae, 0x07, 0xaf, 0x07, 0xce, 0x07, 0xef, 0x07,
+    0xf0, 0x07, 0x3f, 0x09, 0xf1, 0x27, 0x0b, 0x28, 0xbf, 0x3a, 0x11, 0x40, 0xdf, 0x42, 0x40, 0x43,
+    0xf4, 0x4f, 0x15, 0x50, 0xf3, 0x57, 0xf5, 0x57, 0xf6, 0x57, 0xa0, 0x5a, 0xf5, 0x5f, 0x1a, 0x60,
+    0x1b, 0x60, 0x80, 0x61, 0xe0, 0x62, 0xc0, 0x64, 0x04, 0x68, 0x1b, 0x68, 0x00, 0x6d, 0x0d, 0x70,
+    0x1d, 0x70, 0x7f, 0x78, 0x7f, 0x80, 0x40, 0x86, 0x60, 0x94, 0x1f, 0x9a, 0x60, 0x9a, 0x80, 0x9f,
+    0x07, 0xa0, 0x3f, 0xa2, 0xa0, 0xa7, 0xe0, 0xa7, 0xe0, 0xaf, 0xe2, 0xaf, 0x15, 0xb0, 0xe2, 0xb7,
+    0xe4, 0xb7, 0xe5, 0xb7, 0xe0, 0xba, 0x80, 0xbd, 0xe5, 0xbf, 0xea, 0xc7, 0xeb, 0xc7, 0x08, 0xc8,
+    0xeb, 0xcf, 0x19, 0xd8, 0x19, 0xe0, 0xe0, 0xe6, 0xe0, 0xee, 0x00, 0xef, 0xa0, 0xf3, 0xc0, 0xf3,
+    0x0a, 0xf8, 0x0b, 0xf8, 0x6b, 0xf8, 0x8b, 0xf8, 0xde, 0xf8, 0x4e, 0xf9, 0x5e, 0xf9, 0xfe, 0xf9,
+    0xb2, 0xfa, 0xf2, 0xfa, 0x3e, 0xfb, 0x7e, 0xfb, 0xc0, 0xfb, 0x00, 0xfc, 0x84, 0xfc, 0x4a, 0xfd,
+    0x6a, 0xfd, 0x40, 0xff, 0xa3, 0xff, 0xa9, 0xff, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00,
+    0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44,
+    0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01,
+    0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00,
+    0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44,
+    0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01,
+    0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00,
+    0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44,
+    0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01,
+    0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x01, 0x00,
+    0x44, 0x01, 0x00, 0x44, 0x01, 0x00, 0x44, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x14, 0x12, 0x12, 0x12, 0x12, 0x04, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x0f, 0x03, 0x03, 0x03, 0x03, 0x01, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0f, 0x03, 0x03, 0x03, 0x03, 0x01, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0f, 0x03, 0x03, 0x03,
+    0x03, 0x01, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x0f, 0x03, 0x03, 0x03, 0x03, 0x01, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x56, 0x55, 0x55, 0x55, 0x55, 0x53, 0x2f, 0x2f,
+    0x2b, 0x2b, 0x2b, 0x26, 0x3e, 0x3c, 0x3c, 0x3c, 0x3c, 0x35, 0x4f, 0x4e, 0x4e, 0x4e, 0x4e, 0x49,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x54, 0x45, 0x45, 0x45,
+    0x45, 0x2c, 0x28, 0x1e, 0x1e, 0x1e, 0x1e, 0x13, 0x3a, 0x32, 0x32, 0x32, 0x32, 0x24, 0x4b, 0x46,
+    0x46, 0x46, 0x46, 0x2e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x54, 0x45, 0x45, 0x52, 0x52, 0x2c, 0x28, 0x23, 0x23, 0x23, 0x23, 0x13, 0x37, 0x32, 0x32, 0x32,
+    0x32, 0x24, 0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x54, 0x45, 0x45, 0x45, 0x45, 0x2c, 0x27, 0x23, 0x23, 0x23, 0x23, 0x13,
+    0x37, 0x31, 0x31, 0x31, 0x31, 0x24, 0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x54, 0x45, 0x45, 0x45, 0x45, 0x2c, 0x27, 0x1e,
+    0x23, 0x23, 0x23, 0x13, 0x37, 0x31, 0x31, 0x31, 0x31, 0x24, 0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x38, 0x1f, 0x1f, 0x1f,
+    0x1f, 0x1f, 0x17, 0x11, 0x11, 0x11, 0x11, 0x11, 0x29, 0x15, 0x15, 0x15, 0x15, 0x15, 0x3d, 0x22,
+    0x22, 0x22, 0x22, 0x22, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x3e, 0x3c, 0x3c, 0x3c, 0x3c, 0x3c, 0x33, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x37, 0x32, 0x32, 0x32, 0x32, 0x32, 0x24, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x3a, 0x31, 0x31, 0x31, 0x31, 0x31, 0x24, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x3a, 0x31, 0x31, 0x31,
+    0x31, 0x31, 0x24, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x37, 0x31, 0x31, 0x31, 0x31, 0x31, 0x24, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x29, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1c, 0x19, 0x19, 0x19, 0x18, 0x0e, 0x51, 0x51,
+    0x50, 0x50, 0x50, 0x4c, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x2f, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x26, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x10, 0x0c, 0x0c, 0x0c,
+    0x0c, 0x06, 0x4d, 0x4a, 0x4a, 0x4a, 0x4a, 0x34, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x27, 0x1e, 0x23, 0x23,
+    0x23, 0x23, 0x13, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x10, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x4d, 0x4a, 0x4a, 0x4a, 0x4a, 0x34, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x27, 0x1d, 0x23, 0x23, 0x23, 0x23, 0x13, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x10, 0x0a, 0x0a, 0x0a, 0x0b, 0x06, 0x4d, 0x4a, 0x4a, 0x4a, 0x4a, 0x34,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x28, 0x23, 0x23, 0x23, 0x23, 0x23, 0x13, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x10, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x4d, 0x4a,
+    0x4a, 0x4a, 0x4a, 0x34, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x27, 0x1e, 0x23, 0x23, 0x23, 0x23, 0x13, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x07, 0x05, 0x05, 0x05,
+    0x05, 0x05, 0x40, 0x25, 0x25, 0x25, 0x25, 0x25, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x17, 0x11, 0x11, 0x11,
+    0x11, 0x11, 0x11, 0x51, 0x51, 0x50, 0x50, 0x50, 0x4c, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x59, 0x59, 0x59, 0x59, 0x59, 0x57, 0x4f, 0x4e, 0x4e, 0x4e, 0x4e, 0x48, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x51, 0x51, 0x50, 0x50, 0x50, 0x4c,
+    0x59, 0x59, 0x59, 0x59, 0x59, 0x59, 0x57, 0x4d, 0x4a, 0x4a, 0x4a, 0x4a, 0x34, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x58, 0x42, 0x42, 0x42, 0x42, 0x2a, 0x4b, 0x46, 0x46, 0x46, 0x46, 0x2e,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x4d, 0x4a,
+    0x4a, 0x4a, 0x4a, 0x34, 0x58, 0x43, 0x42, 0x42, 0x42, 0x42, 0x2a, 0x4d, 0x4a, 0x4a, 0x4a, 0x4a,
+    0x34, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x58, 0x42, 0x42, 0x42, 0x42, 0x2a, 0x4b, 0x46,
+    0x47, 0x47, 0x47, 0x2e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x4d, 0x4a, 0x4a, 0x4a, 0x4a, 0x34, 0x58, 0x42, 0x43, 0x43, 0x43, 0x43, 0x2a, 0x4d,
+    0x4a, 0x4a, 0x4a, 0x4a, 0x34, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x58, 0x43, 0x43, 0x43,
+    0x43, 0x2a, 0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x4d, 0x4a, 0x4a, 0x4a, 0x4a, 0x34, 0x58, 0x41, 0x42, 0x42,
+    0x42, 0x42, 0x2a, 0x4d, 0x4a, 0x4a, 0x4a, 0x4a, 0x34, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x58, 0x43, 0x43, 0x43, 0x43, 0x2a, 0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x4d, 0x4a, 0x4a, 0x4a, 0x4a, 0x34,
+    0x58, 0x42, 0x42, 0x42, 0x42, 0x42, 0x2a, 0x40, 0x25, 0x25, 0x25, 0x25, 0x25, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x39, 0x20, 0x20, 0x20, 0x20, 0x1b, 0x3d, 0x22, 0x22, 0x22, 0x22, 0x22,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x40, 0x25,
+    0x25, 0x25, 0x25, 0x25, 0x39, 0x20, 0x20, 0x20, 0x20, 0x20, 0x1b, 0x4f, 0x4e, 0x4e, 0x4e, 0x4e,
+    0x48, 0x3e, 0x3c, 0x3c, 0x3c, 0x3c, 0x3c, 0x33, 0x2f, 0x2b, 0x2b, 0x2b, 0x2b, 0x26, 0x56, 0x55,
+    0x55, 0x55, 0x55, 0x53, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x14, 0x12, 0x12, 0x12,
+    0x12, 0x04, 0x56, 0x55, 0x55, 0x55, 0x55, 0x53, 0x1c, 0x19, 0x16, 0x16, 0x16, 0x16, 0x0d, 0x4b,
+    0x46, 0x46, 0x46, 0x46, 0x2e, 0x37, 0x32, 0x32, 0x32, 0x32, 0x32, 0x24, 0x27, 0x1e, 0x23, 0x23,
+    0x23, 0x13, 0x54, 0x44, 0x44, 0x44, 0x44, 0x2c, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x0f, 0x03, 0x03, 0x03, 0x03, 0x01, 0x54, 0x45, 0x45, 0x45, 0x45, 0x2c, 0x10, 0x0a, 0x0a, 0x0a,
+    0x0a, 0x0a, 0x06, 0x4b, 0x46, 0x47, 0x47, 0x47, 0x2e, 0x3a, 0x31, 0x31, 0x31, 0x31, 0x31, 0x24,
+    0x27, 0x1d, 0x23, 0x23, 0x23, 0x13, 0x54, 0x45, 0x45, 0x45, 0x45, 0x2c, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x0f, 0x03, 0x03, 0x03, 0x03, 0x01, 0x54, 0x52, 0x52, 0x52, 0x52, 0x2c,
+    0x10, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e, 0x3a, 0x31, 0x31,
+    0x31, 0x31, 0x31, 0x24, 0x28, 0x23, 0x23, 0x23, 0x23, 0x13, 0x54, 0x45, 0x45, 0x45, 0x45, 0x2c,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0f, 0x03, 0x03, 0x03, 0x03, 0x01, 0x54, 0x44,
+    0x45, 0x44, 0x44, 0x2c, 0x10, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x4b, 0x47, 0x47, 0x47, 0x47,
+    0x2e, 0x37, 0x31, 0x31, 0x31, 0x31, 0x31, 0x24, 0x27, 0x1e, 0x1e, 0x1e, 0x1e, 0x13, 0x54, 0x45,
+    0x45, 0x45, 0x45, 0x2c, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0f, 0x03, 0x03, 0x03,
+    0x03, 0x01, 0x54, 0x45, 0x45, 0x45, 0x45, 0x2c, 0x10, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x3d,
+    0x22, 0x22, 0x22, 0x22, 0x22, 0x29, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x17, 0x11, 0x11, 0x11,
+    0x11, 0x11, 0x38, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x07, 0x05, 0x05, 0x05,
+    0x05, 0x05, 0x05, 0x56, 0x55, 0x55, 0x55, 0x55, 0x53, 0x1c, 0x19, 0x19, 0x19, 0x16, 0x19, 0x0d,
+    0x51, 0x50, 0x50, 0x50, 0x50, 0x4c, 0x3e, 0x3b, 0x3b, 0x3b, 0x3b, 0x31, 0x14, 0x12, 0x12, 0x12,
+    0x12, 0x04, 0x56, 0x55, 0x55, 0x55, 0x55, 0x53, 0x4f, 0x4e, 0x4e, 0x4e, 0x4e, 0x49, 0x1a, 0x16,
+    0x16, 0x19, 0x19, 0x0d, 0x3e, 0x3e, 0x3c, 0x3c, 0x3c, 0x33, 0x4f, 0x4e, 0x4e, 0x4e, 0x4e, 0x49,
+    0x2f, 0x2b, 0x2b, 0x2b, 0x2b, 0x2b, 0x26, 0x54, 0x44, 0x44, 0x44, 0x44, 0x2c, 0x10, 0x0a, 0x0a,
+    0x0a, 0x0a, 0x0a, 0x06, 0x4d, 0x4a, 0x4a, 0x4a, 0x4a, 0x34, 0x36, 0x30, 0x30, 0x30, 0x30, 0x21,
+    0x0f, 0x03, 0x03, 0x03, 0x03, 0x01, 0x54, 0x45, 0x45, 0x45, 0x45, 0x2c, 0x4b, 0x47, 0x47, 0x47,
+    0x47, 0x2e, 0x10, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x37, 0x31, 0x31, 0x31, 0x31, 0x24, 0x4b, 0x47,
+    0x47, 0x47, 0x47, 0x2e, 0x28, 0x23, 0x23, 0x23, 0x23, 0x23, 0x13, 0x54, 0x45, 0x45, 0x45, 0x45,
+    0x2c, 0x10, 0x0a, 0x0a, 0x0a, 0x0a, 0x0b, 0x06, 0x4d, 0x4a, 0x4a, 0x4a, 0x4a, 0x34, 0x36, 0x2d,
+    0x2d, 0x2d, 0x2d, 0x21, 0x0f, 0x03, 0x03, 0x03, 0x03, 0x01, 0x54, 0x45, 0x45, 0x45, 0x45, 0x2c,
+    0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e, 0x10, 0x09, 0x09, 0x0b, 0x0c, 0x06, 0x37, 0x32, 0x32, 0x32,
+    0x32, 0x24, 0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e, 0x27, 0x23, 0x23, 0x23, 0x23, 0x23, 0x13, 0x54,
+    0x45, 0x45, 0x45, 0x45, 0x2c, 0x10, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x4d, 0x4a, 0x4a, 0x4a,
+    0x4a, 0x34, 0x36, 0x30, 0x30, 0x30, 0x30, 0x21, 0x0f, 0x03, 0x03, 0x03, 0x03, 0x01, 0x54, 0x45,
+    0x45, 0x45, 0x45, 0x2c, 0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e, 0x10, 0x0b, 0x0b, 0x0b, 0x0b, 0x06,
+    0x37, 0x32, 0x32, 0x32, 0x32, 0x24, 0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e, 0x28, 0x1e, 0x23, 0x23,
+    0x23, 0x23, 0x13, 0x54, 0x45, 0x45, 0x45, 0x45, 0x2c, 0x10, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06,
+    0x4d, 0x4a, 0x4a, 0x4a, 0x4a, 0x34, 0x36, 0x2d, 0x30, 0x30, 0x30, 0x21, 0x0f, 0x03, 0x03, 0x03,
+    0x03, 0x01, 0x54, 0x45, 0x45, 0x45, 0x45, 0x2c, 0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e, 0x10, 0x0b,
+    0x0a, 0x0a, 0x0a, 0x06, 0x37, 0x32, 0x32, 0x32, 0x32, 0x24, 0x4b, 0x47, 0x47, 0x47, 0x47, 0x2e,
+    0x28, 0x23, 0x23, 0x23, 0x23, 0x23, 0x13, 0x38, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x07, 0x05, 0x05,
+    0x05, 0x05, 0x05, 0x05, 0x3f, 0x25, 0x25, 0x25, 0x25, 0x25, 0x29, 0x15, 0x15, 0x15, 0x15, 0x15,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x3d, 0x22, 0x22, 0x22,
+    0x22, 0x22, 0x07, 0x05, 0x05, 0x05, 0x05, 0x05, 0x29, 0x15, 0x15, 0x15, 0x15, 0x15, 0x3d, 0x22,
+    0x22, 0x22, 0x22, 0x22, 0x17, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x00, 0x1f, 0x00, 0x00, 0x00,
+    0xf3, 0x07, 0x01, 0x01, 0x02, 0x02, 0x00, 0x01, 0x02, 0x01, 0x02, 0x00, 0x01, 0x02, 0x01, 0x02,
+    0x00, 0x01, 0x02, 0x01, 0x02, 0x00, 0x01, 0x02, 0x01, 0x02, 0x00, 0x01, 0x02, 0x01, 0x01, 0x01,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0xf3, 0x07, 0x01, 0x02, 0x01, 0x01, 0x01, 0x02, 0x01, 0x02, 0x01, 0x01,
+    0x02, 0x01, 0x01, 0x02, 0x01, 0x01, 0x02, 0x01, 0x01, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00, 0xf3, 0x07, 0x01, 0x01, 0x02, 0x02, 0x00, 0x01,
+    0x02, 0x01, 0x01, 0x03, 0x01, 0x01, 0x02, 0x01, 0x01, 0x02, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x19, 0x00,
+    0x00, 0x00, 0xf3, 0x07, 0x01, 0x01, 0x02, 0x02, 0x00, 0x01, 0x02, 0x01, 0x01, 0x03, 0x01, 0x01,
+    0x02, 0x01, 0x01, 0x03, 0x01, 0x02, 0x00, 0x01, 0x02, 0x01, 0x01, 0x01, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0xf3, 0x07, 0x01, 0x03,
+    0x01, 0x01, 0x02, 0x02, 0x02, 0x01, 0x01, 0x01, 0x01, 0x02, 0x00, 0x01, 0x02, 0x01, 0x01, 0x00,
+    0x05, 0x01, 0x03, 0x01, 0x01, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0xf3, 0x07, 0x01, 0x01, 0x03, 0x01,
+    0x01, 0x01, 0x01, 0x00, 0x03, 0x02, 0x00, 0x01, 0x02, 0x01, 0x01, 0x03, 0x01, 0x02, 0x00, 0x01,
+    0x02, 0x01, 0x01, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x1d, 0x00, 0x00, 0x00, 0xf3, 0x07, 0x01, 0x01, 0x02, 0x02, 0x00, 0x01,
+    0x02, 0x01, 0x01, 0x00, 0x03, 0x02, 0x00, 0x01, 0x02, 0x01, 0x02, 0x00, 0x01, 0x02, 0x01, 0x02,
+    0x00, 0x01, 0x02, 0x01, 0x01, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0xf3, 0x07, 0x01, 0x00, 0x04, 0x01,
+    0x03, 0x01, 0x01, 0x02, 0x01, 0x01, 0x02, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1d, 0x00, 0x00, 0x00,
+    0xf3, 0x07, 0x01, 0x01, 0x02, 0x02, 0x00, 0x01, 0x02, 0x01, 0x02, 0x00, 0x01, 0x02, 0x01, 0x01,
+    0x01, 0x02, 0x02, 0x00, 0x01, 0x02, 0x01, 0x02, 0x00, 0x01, 0x02, 0x01, 0x01, 0x01, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1d, 0x00,
+    0x00, 0x00, 0xf3, 0x07, 0x01, 0x01, 0x02, 0x02, 0x00, 0x01, 0x02, 0x01, 0x02, 0x00, 0x01, 0x02,
+    0x01, 0x02, 0x00, 0x01, 0x02, 0x01, 0x01, 0x01, 0x03, 0x02, 0x00, 0x01, 0x02, 0x01, 0x01, 0x01,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x44, 0x00, 0x00, 0x00, 0xf3, 0x07, 0x01, 0x01, 0x03, 0x06, 0x00, 0x01, 0x05, 0x03, 0x03, 0x02,
+    0x02, 0x01, 0x01, 0x02, 0x03, 0x02, 0x07, 0x00, 0x02, 0x03, 0x01, 0x05, 0x01, 0x02, 0x01, 0x01,
+    0x02, 0x04, 0x01, 0x02, 0x01, 0x06, 0x02, 0x02, 0x01, 0x01, 0x05, 0x01, 0x02, 0x01, 0x01, 0x01,
+    0x05, 0x04, 0x06, 0x03, 0x01, 0x01, 0x01, 0x05, 0x01, 0x02, 0x01, 0x01, 0x01, 0x05, 0x01, 0x05,
+    0x00, 0x03, 0x03, 0x03, 0x03, 0x02, 0x02, 0x01, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x00,
+    0x00, 0x00, 0xf3, 0x07, 0x01, 0x19, 0x01, 0x02, 0x01, 0x03, 0x15, 0x01, 0x05, 0x00, 0x01, 0x04,
+    0x03, 0x04, 0x02, 0x03, 0x02, 0x04, 0x03, 0x09, 0x00, 0x02, 0x03, 0x01, 0x02, 0x01, 0x02, 0x01,
+    0x02, 0x01, 0x01, 0x01, 0x02, 0x01, 0x02, 0x01, 0x02, 0x01, 0x07, 0x02, 0x02, 0x01, 0x01, 0x02,
+    0x01, 0x02, 0x04, 0x01, 0x04, 0x02, 0x01, 0x02, 0x01, 0x07, 0x03, 0x01, 0x01, 0x01, 0x02, 0x01,
+    0x02, 0x01, 0x04, 0x01, 0x05, 0x01, 0x02, 0x01, 0x05, 0x00, 0x03, 0x02, 0x03, 0x04, 0x03, 0x02,
+    0x03, 0x03, 0x03, 0x01, 0x05, 0x01, 0x01, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x00, 0x00, 0x00, 0x60, 0xfe,
+    0x02, 0x00, 0x04, 0x18, 0x01, 0x03, 0x00, 0x01, 0x02, 0x01, 0x18, 0x01, 0x08, 0x00, 0x01, 0x02,
+    0x01, 0x01, 0x04, 0x01, 0x01, 0x02, 0x01, 0x02, 0x03, 0x02, 0x02, 0x03, 0x03, 0x09, 0x00, 0x04,
+    0x04, 0x01, 0x01, 0x01, 0x02, 0x01, 0x01, 0x01, 0x04, 0x01, 0x02, 0x01, 0x01, 0x01, 0x02, 0x01,
+    0x08, 0x00, 0x01, 0x05, 0x03, 0x01, 0x01, 0x02, 0x01, 0x02, 0x02, 0x02, 0x04, 0x01, 0x01, 0x02,
+    0x01, 0x09, 0x00, 0x01, 0x04, 0x01, 0x02, 0x01, 0x01, 0x01, 0x02, 0x01, 0x04, 0x01, 0x01, 0x01,
+    0x04, 0x01, 0x02, 0x01, 0x06, 0x00, 0x01, 0x04, 0x04, 0x02, 0x03, 0x01, 0x03, 0x03, 0x03, 0x02,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+#endif /* _GAME_TETRIS_BUNDLE_H_ */
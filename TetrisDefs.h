@@ -11,6 +11,31 @@
 **
 ** when          who             what, where, why
 ** ----------    ------------    --------------------------------
+** 2026-10-19    me              Cut loop restarts after its effect.
+** 2026-10-19    me              Record comment names the legacy writes.
+** 2026-10-19    me              Benchmark on request.
+** 2026-10-19    me              Bundle report flag.
+** 2026-10-19    me              Paused and cut loop states.
+** 2026-10-19    me              Golden frames.
+** 2026-10-19    me              Replay format.
+** 2026-10-19    me              Seeded piece generator, 7-bag mode.
+** 2026-10-19    me              Soak harness.
+** 2026-10-19    me              Memory accounting.
+** 2026-10-19    me              Frame-budget watchdog.
+** 2026-10-19    me              Performance overlay.
+** 2026-10-19    me              Binary trace ring.
+** 2026-10-19    me              Render benchmark.
+** 2026-10-19    me              Logic benchmark.
+** 2026-10-19    me              Tone renderer.
+** 2026-10-19    me              Background loop.
+** 2026-10-19    me              Sound effect scheduler.
+** 2026-10-19    me              Indexed asset bundle.
+** 2026-10-19    me              Pre-decoded image atlas.
+** 2026-10-19    me              Top-N leaderboard per level.
+** 2026-10-19    me              Suspend snapshot.
+** 2026-10-19    me              Packed settings record.
+** 2026-10-19    me              Key latency trace.
+** 2026-10-19    me              Ghost piece.
 ** 2024-11-22    me              Created.
 **
 ** ===========================================================================
@@ -38,16 +63,136 @@ extern "C" {
 #define MAX_REM_LINES    4  // Max number of lines deleted once
 #define MAX_FLASH_TIMES  3  // Max flash times when delete a full line
 #define MAX_BLOCK_KIND   7  // Max number of types supported
+#define MAX_COLUMN_NUMBER 16 // Max playing zone columns, a row is mapped by an U16
+#define MAX_ROW_NUMBER   21 // Max playing zone rows
 
 #define INIT_TIME        900    // The initial time in easy level a block stops
 #define TIME_SLICE       50     // The time decrement when level adds(ms)
 #define FLASH_TIME       200    // Used to set timer
 #define OVER_TIME        100    // Used to set timer when game is over
+#define SAVE_TIME        500    // Used to set timer to save the settings once the game is idle
+#define SOUND_FRAME_TIME 20     // Sound requests within this time are merged into one
+#define SOUND_HOLD_TIME  3000   // An effect without its end callback is taken as over after this(ms)
+#define BGM_DUCK_SHIFT   1      // The loop plays at volume >> this under an effect(multichannel)
 #define LEVEL_SCORE      500    // Max score in a level  
 
 #define COLOR_BACKGROUND    gui_color(0,0,0)
+#define GHOST_COLOR_SHIFT   2   // the ghost is drawn with the tetris color >> this
 
 #define TETRIS_VERSION 2  
+#define TETRIS_RECORD_VERSION 2 // Layout of CTetrisRecord
+#define TETRIS_BOARD_SIZE     5 // Leaderboard entries kept per level
+#define TETRIS_SNAPSHOT_VERSION 2 // Layout of the suspend snapshot
+#define TETRIS_RANDOMIZER RANDOMIZER_UNIFORM // How new games deal the models, see RandomizerEnum
+
+// 24 bytes of state, 5 of the generator and the rest of its bag, a row map
+// per row and 3 bits per pinned grid
+#define TETRIS_SNAPSHOT_SIZE  (24 + 5 + MAX_BLOCK_KIND + MAX_ROW_NUMBER * 2 + \
+                               (MAX_ROW_NUMBER * MAX_COLUMN_NUMBER * 3 + 7) / 8)
+
+// Log the ROM and RAM bytes, uses and first load time of every bundle
+// entry when the game exits, see bundleReport
+//#define __TETRIS_BUNDLE_REPORT__
+
+// Measure the time from a key event to the first present showing it
+//#define __TETRIS_LATENCY_TRACE__
+
+#define LATENCY_BUCKET_US   250     // latency histogram resolution
+#define LATENCY_BUCKETS     128     // the last bucket collects everything above
+
+// Play the effects from the pre-parsed note lists of TetrisResDef.h as
+// square waves instead of handing the SMF to the audio driver
+//#define __TETRIS_TONE_RENDERER__
+
+#define TONE_SAMPLE_RATE    8000    // 8 bit mono, music/mid2h.py uses the same rate
+#define TONE_SLOTS          2       // the effect playing stays intact while the next one renders
+#define TONE_SLOT_SAMPLES   10000   // 1.25s, longer effects go to the SMF path
+#define TONE_WAV_HEADER     44
+
+// Time the game logic hot paths and the draw paths at every shipped screen
+// size when B is pressed on the PC keyboard, the results go to
+// tetris_bench.json, see benchTheGame
+//#define __TETRIS_BENCHMARK__
+
+#define BENCH_SEED          20261019    // fixtures are the same in every run
+#define BENCH_MIN_TICKS     8192        // 250ms of 32K ticks per case and implementation
+#define BENCH_BATCH         16          // operations between two clock reads
+#define BENCH_JSON_SIZE     12288
+
+// Binary trace ring: 0 is off, 1 records the game flow, 2 the hot paths too.
+// A host build writes the ring as Chrome trace json when the game exits.
+#define TETRIS_TRACE_LEVEL  0
+
+#define TRACE_RING_SIZE     512     // events, a power of two
+
+// Overlay of the last second in the top left corner: frame time, fills,
+// blits, pixels, overdraw and game timer lateness; the 0 key toggles it
+//#define __TETRIS_PERF_HUD__
+
+#define HUD_PERIOD          1000    // ms between two updates of the overlay
+#define HUD_TIMERS          4       // game timers followed at the same time
+
+// Time every game timer callback and key handler, log the ones over the
+// budget with their call path and draw counts, see watchdogLeave
+//#define __TETRIS_WATCHDOG__
+
+#define WATCHDOG_BUDGET_MS  20      // one frame of the slowest LCD refresh
+#define WATCHDOG_PATH       8       // functions kept of one call path
+#define WATCHDOG_BUCKETS    8       // below 1, 2, 4 ... 64ms and above
+
+// Account every TETRIS_ALLOC and TETRIS_FREE: bytes in use, peak, per call
+// site, leaks and double frees, reported at exit, see memoryReport
+//#define __TETRIS_MEM_ACCOUNT__
+
+#define MEM_BLOCKS          64      // live blocks followed: rows, two arrays, covered area, assets
+#define MEM_SITES           8       // TETRIS_ALLOC lines, the last one collects the rest
+
+// Host soak, S on the PC keyboard plays SOAK_PIECES headless on a virtual
+// clock through pauses, levels, game overs and exits, see soakTheGame
+//#define __TETRIS_SOAK__
+
+#define SOAK_PIECES         1000000
+#define SOAK_SEED           20261019
+#define SOAK_CYCLE_PIECES   2000    // at most between entering and leaving the game
+#define SOAK_PAUSE_ODDS     64      // one piece in that many pauses first
+#define SOAK_RANDOM_ODDS    8       // one piece in that many is placed at random
+
+// Record every game as its seed, its inputs and a keyframe every few pieces
+// in tetris_replay.trp and play such a file back from any keyframe, see
+// replayTheGame
+//#define __TETRIS_REPLAY__
+
+#define REPLAY_VERSION      1
+#define REPLAY_SIZE         16384   // bytes of one recorded game, the rest is not recorded
+#define REPLAY_KEYFRAME_PIECES 50   // pieces between two keyframes
+#define VIRTUAL_TIMERS      8       // timers pending at the same time on the virtual clock
+
+// Golden frames, G on the PC keyboard plays tetris_golden.trp on a stand-in
+// layer and compares the hash and the fills, blits and pixels of every
+// present with tetris_golden.gld; without that file the run writes it, see
+// goldenTheGame
+//#define __TETRIS_GOLDEN__
+
+#define GOLDEN_VERSION      1
+#define GOLDEN_REPORTED     8       // differing frames logged one by one
+
+#if defined(__TETRIS_GOLDEN__) && !defined(__TETRIS_REPLAY__)
+#define __TETRIS_REPLAY__           // the fixed game
+#endif
+#if defined(__TETRIS_SOAK__) || defined(__TETRIS_REPLAY__)
+#define __TETRIS_VIRTUAL_CLOCK__
+#endif
+#if defined(__TETRIS_SOAK__) && !defined(__TETRIS_MEM_ACCOUNT__)
+#define __TETRIS_MEM_ACCOUNT__      // the leak check of every cycle
+#endif
+
+#if defined(__TETRIS_BENCHMARK__) || defined(__TETRIS_PERF_HUD__) || defined(__TETRIS_WATCHDOG__) || \
+    defined(__TETRIS_GOLDEN__)
+#define __TETRIS_RENDER_COUNT__
+#endif
+#if TETRIS_TRACE_LEVEL > 0 && !defined(__MTK_TARGET__)
+#define __TETRIS_TRACE_EXPORT__
+#endif
 
 /*
 **----------------------------------------------------------------------------
@@ -91,9 +236,24 @@ typedef enum
     ACTION_DOWN,
     ACTION_LEFT,
     ACTION_RIGHT,
-    ACTION_ROTATE  
+    ACTION_ROTATE,
+    ACTION_PAUSE,
+    ACTION_NUMBER
 } ActionTypeEnum;
 
+typedef enum
+{
+    RANDOMIZER_UNIFORM,         // every model with the same odds, independent of the last ones
+    RANDOMIZER_BAG              // the 7 models in a shuffled set, then the next set
+} RandomizerEnum;
+
+// codes of a replay record besides ActionTypeEnum, 3 bits
+typedef enum
+{
+    REPLAY_CONTINUE = ACTION_NUMBER,    // the level prompt was answered with its soft key
+    REPLAY_KEYFRAME = 7                 // pieces, state hash and a snapshot follow
+} ReplayCodeEnum;
+
 typedef enum
 {
 	MUSIC_TITLE,
@@ -102,17 +262,118 @@ typedef enum
     MUSIC_MULLINES,
     MUSIC_NEXTSPEED,
     MUSIC_NEXTLEVEL,
-    MUSIC_GAMEOVER
+    MUSIC_GAMEOVER,
+    MUSIC_NUMBER
 } MusicTypeEnum;
 
+typedef enum
+{
+    BGM_STOPPED,    // nothing of the loop on the device
+    BGM_PLAYING,
+    BGM_DUCKED,     // under an effect at a lower volume(multichannel)
+    BGM_PAUSED,     // kept at its position while the game does not run(multichannel)
+    BGM_CUT         // a rare effect took the string player, the loop starts again after it(single channel)
+} BgmStateEnum;
+
+typedef enum
+{
+    TRACE_STATE,                // new state, previous state
+    TRACE_LAUNCH,               // model, next model
+    TRACE_ROWS,                 // rows deleted, topmost pinned row
+    TRACE_SOUND_PLAY,           // effect, mdi result
+    TRACE_SOUND_DROPPED,        // effect, effect playing
+    TRACE_KEY,                  // ActionTypeEnum, 0
+    TRACE_TIMER_REFUSED,        // state, elapse
+    TRACE_ROTATE_BOUNDS,        // xMin, yMin after the turn
+    TRACE_ROTATE_BLOCKED,       // column, row
+    TRACE_KICK_RIGHT_BLOCKED,   // column, row
+    TRACE_KICK_LEFT_BLOCKED,    // column, row
+    TRACE_KICK_DOWN_BLOCKED,    // column, row
+    TRACE_SOUND_REQUEST,        // effect, sound on
+    TRACE_PRESENT,              // width, height
+    TRACE_EVENT_NUMBER
+} TraceEventEnum;
+
+typedef enum
+{
+    WATCHDOG_GRAVITY,           // moveDownwardsIf
+    WATCHDOG_FLASH,             // flashWhenDeleteDirtyRows
+    WATCHDOG_GAME_OVER,         // gameOver, clearPlayingZoneAfterGameOver
+    WATCHDOG_NEXT_LEVEL,        // continueAtTheNextLevel
+    WATCHDOG_KEY,               // Tetris_<n>Key
+    WATCHDOG_KIND_NUMBER
+} WatchdogKindEnum;
+
+// one trace record, 16 bytes
+typedef struct _CTraceEvent
+{
+    U32     time;               // drv_get_current_time()
+    U16     event;              // TraceEventEnum
+    U16     reserved;
+    S32     a;
+    S32     b;
+} CTraceEvent;
+
+// one note of an effect, generated by music/mid2h.py
+typedef struct _CToneEvent
+{
+    U16     start;              // ms from the start of the effect
+    U16     length;             // ms
+    U16     step;               // phase step per sample, 0x10000 is one period
+    U8      volume;             // square wave amplitude
+    U8      reserved;
+} CToneEvent;
+
+// one leaderboard line, 12 bytes
+typedef struct _CScoreEntry
+{
+    U32		score;              // 0 if the line is empty
+    U16		lines;              // rows deleted in the game
+    U16		speed;              // speed reached
+    U32		timestamp;          // end of the game, UTC seconds
+} CScoreEntry;
+
 typedef struct _CPrefData
 {
     uint8	gameLevel;
     BOOL	soundOn;
     BOOL	drawGridLines;
-    U16		topScore[MAX_LEVEL];
+    CScoreEntry leaderboard[MAX_LEVEL][TETRIS_BOARD_SIZE]; // best first
 } CPrefData;                             
 
+// NVRAM_EF_GX_TETRIS_DATA_LID, the settings and leaderboards of the game.
+// flushSettingData also writes the legacy level byte and per level grade
+// values for the framework menu, the game reads them back only to migrate
+// when this record is missing or invalid
+typedef struct _CTetrisRecord
+{
+    U8		version;            // TETRIS_RECORD_VERSION
+    U8		gameLevel;          // 1 .. MAX_LEVEL
+    U8		drawGridLines;
+    U8		reserved;
+    CScoreEntry leaderboard[MAX_LEVEL][TETRIS_BOARD_SIZE]; // best first
+    U16		checksum;           // fletcher-16 of the fields above
+} CTetrisRecord;
+
+// blob layouts of TetrisBundle.h, see GameImages/img2bundle.py
+typedef enum
+{
+    BUNDLE_SPANS565,                // spans and RGB565 pixels, drawn in place
+    BUNDLE_SPANS8,                  // spans and palette indices, expanded on first use
+    BUNDLE_FORMAT_NUMBER
+} BundleFormatEnum;
+
+// an image of the bundle, 10 bytes
+typedef struct _CBundleEntry
+{
+    U16		imageId;            // the PNG resource, drawn if the layer is not 16 bit
+    U8		width;
+    U8		height;
+    U8		format;             // BundleFormatEnum
+    U16		offset;             // in tetris_bundle, entries may share a blob
+    U16		size;
+} CBundleEntry;
+
 typedef struct _CBlock
 {
     S16 x;
@@ -127,6 +388,16 @@ typedef struct _CTetris
     CBlock	block[4]; // the 4 blocks consisting a tetris
 } CTetris;
 
+typedef struct _CGhost
+{
+    BOOL    valid;          // tetris below matches the key below
+    BOOL    drawn;          // tetris below is on the screen
+    U8      column[4];      // key: the column of every falling block
+    S8      rowOffset[4];   // key: the row of every falling block, relative to the 1st one
+    U8      columnTop[4];   // key: the topmost pinned row of every column above
+    CTetris tetris;         // where the falling tetris would land
+} CGhost;
+
 typedef struct Grid
 {
     BOOL dirty;
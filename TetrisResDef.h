@@ -5,12 +5,15 @@
 **     TetrisResDef.h
 **
 ** Description: 
-**     Tetris Resource Definitions
+**     Tetris Resource Definitions, generated by music/mid2h.py from the
+**     MIDI files in music, do not edit.
 ** 
 ** History: 
 **
 ** when          who             what, where, why
 ** ----------    ------------    --------------------------------
+** 2026-10-19    me              Pre-parsed tone lists.
+** 2026-10-19    me              Generated, shared effects stored once.
 ** 2024-11-24	 me				 Success snd
 ** 2024-11-24    me              Alignment.
 ** 2024-11-22    me              Created.
@@ -48,6 +51,22 @@ extern "C" {
 **----------------------------------------------------------------------------
 */
 
+/*
+** blink.mid          269 bytes, 16 notes
+** drop.mid           389 bytes, 2 notes
+** droppiece.mid       98 bytes, 1 notes
+** fail.mid           143 bytes, 4 notes
+** hero.mid           236 bytes, 24 notes
+** mullines.mid         0 bytes, shares tetris_sfx_drop, 2 notes
+** over.mid           143 bytes, 0 notes
+** select.mid         110 bytes, 3 notes
+** singleline.mid     104 bytes, 2 notes
+** success.mid        134 bytes, 3 notes
+** title.mid         1353 bytes, 94 notes
+** undrop.mid         110 bytes, 3 notes
+** total             3089 bytes, 12 effects, 11 stored
+*/
+
 #define tetris_sfx_blink_size 269
 #define tetris_sfx_drop_size 389
 #define tetris_sfx_droppiece_size 98
@@ -60,10 +79,11 @@ extern "C" {
 #define tetris_sfx_success_size 134
 #define tetris_sfx_title_size 1353
 #define tetris_sfx_undrop_size 110
+#define tetris_sfx_mullines tetris_sfx_drop
 
 /* Contents of file blink.mid */
 __align(2)
-	U8 tetris_sfx_blink[269] = {
+	const U8 tetris_sfx_blink[269] = {
 	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x05, 0x00, 0x78, 0x4D, 0x54,
 	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
 	    0x65, 0x64, 0x00, 0xFF, 0x01, 0x02, 0x6A, 0x6A, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08,
@@ -85,7 +105,7 @@ __align(2)
 
 /* Contents of file drop.mid */
 __align(2)
-	U8 tetris_sfx_drop[389] = {
+	const U8 tetris_sfx_drop[389] = {
 	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x03, 0x00, 0x78, 0x4D, 0x54,
 	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
 	    0x65, 0x64, 0x00, 0xFF, 0x01, 0x02, 0x6A, 0x6A, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08,
@@ -115,7 +135,7 @@ __align(2)
 
 /* Contents of file droppiece.mid */
 __align(2)
-	U8 tetris_sfx_droppiece[98] = {
+	const U8 tetris_sfx_droppiece[98] = {
 	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x02, 0x00, 0x78, 0x4D, 0x54,
 	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
 	    0x65, 0x64, 0x00, 0xFF, 0x01, 0x02, 0x6A, 0x6A, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08,
@@ -127,7 +147,7 @@ __align(2)
 
 /* Contents of file fail.mid */
 __align(2)
-	U8 tetris_sfx_fail[143] = {
+	const U8 tetris_sfx_fail[143] = {
 	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x03, 0x00, 0x78, 0x4D, 0x54,
 	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
 	    0x65, 0x64, 0x00, 0xFF, 0x01, 0x02, 0x6A, 0x6A, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08,
@@ -141,7 +161,7 @@ __align(2)
 
 /* Contents of file hero.mid */
 __align(2)
-	U8 tetris_sfx_hero[236] = {
+	const U8 tetris_sfx_hero[236] = {
 	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x02, 0x00, 0x78, 0x4D, 0x54,
 	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
 	    0x65, 0x64, 0x00, 0xFF, 0x01, 0x02, 0x6A, 0x6A, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08,
@@ -159,39 +179,9 @@ __align(2)
 	    0x3D, 0x64, 0x0F, 0x3D, 0x00, 0x00, 0x39, 0x00, 0x00, 0xFF, 0x2F, 0x00
 	};
 
-/* Contents of file mullines.mid */
-__align(2)
-	U8 tetris_sfx_mullines[389] = {
-	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x03, 0x00, 0x78, 0x4D, 0x54,
-	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
-	    0x65, 0x64, 0x00, 0xFF, 0x01, 0x02, 0x6A, 0x6A, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08,
-	    0x00, 0xFF, 0x59, 0x02, 0x00, 0x00, 0x00, 0xFF, 0x51, 0x03, 0x06, 0x1A, 0x80, 0x00, 0xFF, 0x2F,
-	    0x00, 0x4D, 0x54, 0x72, 0x6B, 0x00, 0x00, 0x01, 0x25, 0x00, 0xFF, 0x03, 0x00, 0x00, 0xC0, 0x50,
-	    0x00, 0xB0, 0x07, 0x64, 0x00, 0x0A, 0x40, 0x00, 0x65, 0x00, 0x01, 0x64, 0x00, 0x01, 0x06, 0x23,
-	    0x01, 0x26, 0x14, 0x00, 0x90, 0x27, 0x64, 0x00, 0xE0, 0x00, 0x43, 0x00, 0x00, 0x1E, 0x00, 0x00,
-	    0x20, 0x03, 0x00, 0x21, 0x02, 0x00, 0x24, 0x02, 0x00, 0x25, 0x02, 0x00, 0x27, 0x02, 0x00, 0x28,
-	    0x01, 0x00, 0x29, 0x01, 0x00, 0x2B, 0x03, 0x00, 0x2C, 0x02, 0x00, 0x2F, 0x01, 0x00, 0x32, 0x02,
-	    0x00, 0x34, 0x01, 0x00, 0x36, 0x02, 0x00, 0x38, 0x01, 0x00, 0x3A, 0x02, 0x00, 0x3C, 0x02, 0x00,
-	    0x3F, 0x01, 0x00, 0x41, 0x03, 0x00, 0x42, 0x01, 0x00, 0x45, 0x01, 0x00, 0x46, 0x01, 0x00, 0x48,
-	    0x01, 0x00, 0x4A, 0x02, 0x00, 0x4B, 0x01, 0x00, 0x4C, 0x02, 0x90, 0x27, 0x00, 0x00, 0xE0, 0x00,
-	    0x4D, 0x01, 0x00, 0x50, 0x02, 0x00, 0x52, 0x01, 0x00, 0x54, 0x02, 0x00, 0x50, 0x01, 0x00, 0x42,
-	    0x02, 0x00, 0x43, 0x01, 0x00, 0x44, 0x03, 0x00, 0x45, 0x02, 0x90, 0x27, 0x64, 0x02, 0xE0, 0x00,
-	    0x46, 0x02, 0x00, 0x47, 0x02, 0x00, 0x48, 0x01, 0x00, 0x49, 0x02, 0x00, 0x4A, 0x01, 0x00, 0x4B,
-	    0x03, 0x00, 0x4C, 0x02, 0x00, 0x4D, 0x01, 0x00, 0x4E, 0x02, 0x00, 0x4F, 0x01, 0x00, 0x51, 0x02,
-	    0x00, 0x53, 0x03, 0x00, 0x54, 0x02, 0x00, 0x55, 0x01, 0x00, 0x56, 0x01, 0x00, 0x58, 0x02, 0x00,
-	    0x59, 0x01, 0x00, 0x5A, 0x01, 0x00, 0x5D, 0x01, 0x00, 0x5E, 0x01, 0x00, 0x5F, 0x02, 0x00, 0x60,
-	    0x01, 0x00, 0x61, 0x02, 0x00, 0x62, 0x01, 0x00, 0x63, 0x02, 0x00, 0x64, 0x01, 0x00, 0x65, 0x01,
-	    0x00, 0x67, 0x01, 0x00, 0x68, 0x01, 0x00, 0x69, 0x03, 0x00, 0x6B, 0x01, 0x00, 0x6C, 0x01, 0x00,
-	    0x6D, 0x01, 0x00, 0x6E, 0x02, 0x00, 0x70, 0x02, 0x00, 0x71, 0x01, 0x00, 0x72, 0x01, 0x00, 0x73,
-	    0x02, 0x00, 0x75, 0x02, 0x00, 0x7B, 0x01, 0x00, 0x7C, 0x01, 0x00, 0x7E, 0x02, 0x7F, 0x7F, 0x08,
-	    0x7F, 0x7F, 0x01, 0x90, 0x27, 0x00, 0x0B, 0xE0, 0x7F, 0x7F, 0x00, 0xFF, 0x2F, 0x00, 0x4D, 0x54,
-	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x0F, 0x00, 0xFF, 0x03, 0x00, 0x00, 0xB1, 0x07, 0x64, 0x00, 0x0A,
-	    0x40, 0x00, 0xFF, 0x2F, 0x00
-	};
-
 /* Contents of file over.mid */
 __align(2)
-	U8 tetris_sfx_over[143] = {
+	const U8 tetris_sfx_over[143] = {
 	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x02, 0x00, 0x78, 0x4D, 0x54,
 	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
 	    0x65, 0x64, 0x00, 0xFF, 0x01, 0x02, 0x6A, 0x6A, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08,
@@ -205,7 +195,7 @@ __align(2)
 
 /* Contents of file select.mid */
 __align(2)
-	U8 tetris_sfx_select[110] = {
+	const U8 tetris_sfx_select[110] = {
 	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x02, 0x00, 0x78, 0x4D, 0x54,
 	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
 	    0x65, 0x64, 0x00, 0xFF, 0x01, 0x02, 0x6A, 0x6A, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08,
@@ -215,23 +205,9 @@ __align(2)
 	    0x64, 0x07, 0x3B, 0x00, 0x08, 0x47, 0x00, 0x00, 0x4E, 0x00, 0x00, 0xFF, 0x2F, 0x00
 	};
 
-/* Contents of file success.mid */
-__align(2)
-	U8 tetris_sfx_success[134] = {
-		0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x01, 0x03, 0xC0, 0x4D, 0x54,
-		0x72, 0x6B, 0x00, 0x00, 0x00, 0x70, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
-		0x65, 0x64, 0x00, 0xFF, 0x02, 0x1A, 0x43, 0x6F, 0x70, 0x79, 0x72, 0x69, 0x67, 0x68, 0x74, 0x20,
-		0xA9, 0x20, 0x32, 0x30, 0x30, 0x31, 0x20, 0x62, 0x79, 0x20, 0x3C, 0x6E, 0x61, 0x6D, 0x65, 0x3E,
-		0x00, 0xFF, 0x01, 0x10, 0x4D, 0x69, 0x63, 0x68, 0x65, 0x6C, 0x6C, 0x65, 0x20, 0x46, 0x75, 0x68,
-		0x72, 0x6D, 0x61, 0x6E, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08, 0x00, 0xFF, 0x59, 0x02,
-		0x00, 0x00, 0x00, 0xFF, 0x51, 0x03, 0x0C, 0x35, 0x00, 0x00, 0xC0, 0x0C, 0x00, 0x90, 0x4D, 0x7F,
-		0x81, 0x70, 0x51, 0x7F, 0x78, 0x4D, 0x00, 0x53, 0x4D, 0x7F, 0x81, 0x1D, 0x51, 0x00, 0x86, 0x23,
-		0x4D, 0x00, 0x00, 0xFF, 0x2F, 0x00
-	};
-
 /* Contents of file singleline.mid */
 __align(2)
-	U8 tetris_sfx_singleline[104] = {
+	const U8 tetris_sfx_singleline[104] = {
 	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x02, 0x00, 0x78, 0x4D, 0x54,
 	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
 	    0x65, 0x64, 0x00, 0xFF, 0x01, 0x02, 0x6A, 0x6A, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08,
@@ -241,9 +217,23 @@ __align(2)
 	    0x00, 0x11, 0x4C, 0x00, 0x00, 0xFF, 0x2F, 0x00
 	};
 
+/* Contents of file success.mid */
+__align(2)
+	const U8 tetris_sfx_success[134] = {
+	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x01, 0x03, 0xC0, 0x4D, 0x54,
+	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x70, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
+	    0x65, 0x64, 0x00, 0xFF, 0x02, 0x1A, 0x43, 0x6F, 0x70, 0x79, 0x72, 0x69, 0x67, 0x68, 0x74, 0x20,
+	    0xA9, 0x20, 0x32, 0x30, 0x30, 0x31, 0x20, 0x62, 0x79, 0x20, 0x3C, 0x6E, 0x61, 0x6D, 0x65, 0x3E,
+	    0x00, 0xFF, 0x01, 0x10, 0x4D, 0x69, 0x63, 0x68, 0x65, 0x6C, 0x6C, 0x65, 0x20, 0x46, 0x75, 0x68,
+	    0x72, 0x6D, 0x61, 0x6E, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08, 0x00, 0xFF, 0x59, 0x02,
+	    0x00, 0x00, 0x00, 0xFF, 0x51, 0x03, 0x0C, 0x35, 0x00, 0x00, 0xC0, 0x0C, 0x00, 0x90, 0x4D, 0x7F,
+	    0x81, 0x70, 0x51, 0x7F, 0x78, 0x4D, 0x00, 0x53, 0x4D, 0x7F, 0x81, 0x1D, 0x51, 0x00, 0x86, 0x23,
+	    0x4D, 0x00, 0x00, 0xFF, 0x2F, 0x00
+	};
+
 /* Contents of file title.mid */
 __align(2)
-	U8 tetris_sfx_title[1353] = {
+	const U8 tetris_sfx_title[1353] = {
 	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x11, 0x01, 0xE0, 0x4D, 0x54,
 	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x1D, 0x00, 0xF0, 0x05, 0x7E, 0x7F, 0x09, 0x01, 0xF7, 0x00, 0xFF,
 	    0x51, 0x03, 0x06, 0x8A, 0x1B, 0x00, 0xF0, 0x07, 0x7F, 0x7F, 0x04, 0x01, 0x7F, 0x7F, 0xF7, 0x00,
@@ -333,7 +323,7 @@ __align(2)
 
 /* Contents of file undrop.mid */
 __align(2)
-	U8 tetris_sfx_undrop[110] = {
+	const U8 tetris_sfx_undrop[110] = {
 	    0x4D, 0x54, 0x68, 0x64, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x02, 0x00, 0x78, 0x4D, 0x54,
 	    0x72, 0x6B, 0x00, 0x00, 0x00, 0x2B, 0x00, 0xFF, 0x03, 0x08, 0x75, 0x6E, 0x74, 0x69, 0x74, 0x6C,
 	    0x65, 0x64, 0x00, 0xFF, 0x01, 0x02, 0x6A, 0x6A, 0x00, 0xFF, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08,
@@ -343,6 +333,207 @@ __align(2)
 	    0x64, 0x01, 0x35, 0x00, 0x0C, 0x39, 0x00, 0x00, 0x45, 0x00, 0x00, 0xFF, 0x2F, 0x00
 	};
 
+#ifdef __TETRIS_TONE_RENDERER__
+#define tetris_tone_blink_count 16
+#define tetris_tone_drop_count 2
+#define tetris_tone_droppiece_count 1
+#define tetris_tone_fail_count 4
+#define tetris_tone_hero_count 24
+#define tetris_tone_mullines_count 2
+#define tetris_tone_over_count 0
+#define tetris_tone_select_count 3
+#define tetris_tone_singleline_count 2
+#define tetris_tone_success_count 3
+#define tetris_tone_title_count 94
+#define tetris_tone_undrop_count 3
+#define tetris_tone_mullines tetris_tone_drop
+
+const CToneEvent tetris_tone_blink[16] = {
+	{    0,    75,   901, 25},
+	{   75,    75,  1072, 25},
+	{  105,    75,   901, 25},
+	{  150,    75,  2023, 25},
+	{  180,    75,  1072, 25},
+	{  195,    75,   901, 25},
+	{  225,    75,  4046, 25},
+	{  255,    75,  2023, 25},
+	{  270,    75,  1072, 25},
+	{  295,    75,   901, 25},
+	{  330,    75,  4046, 25},
+	{  345,    75,  2023, 25},
+	{  370,    75,  1072, 25},
+	{  420,    75,  4046, 25},
+	{  445,    75,  2023, 25},
+	{  520,    75,  4046, 25}
+};
+
+const CToneEvent tetris_tone_drop[2] = {
+	{   10,   140,   637, 25},
+	{  200,   250,   637, 25}
+};
+
+const CToneEvent tetris_tone_droppiece[1] = {
+	{    0,    75,  1606, 25}
+};
+
+const CToneEvent tetris_tone_fail[4] = {
+	{    0,    62, 12124, 25},
+	{    0,    62, 12124, 25},
+	{  250,   187,  9623, 25},
+	{  250,   187,  9623, 25}
+};
+
+const CToneEvent tetris_tone_hero[24] = {
+	{    0,    75,  1802, 25},
+	{    0,    75,  2271, 25},
+	{   75,    75,  1802, 16},
+	{   75,    75,  2271, 16},
+	{  150,    75,  1802, 14},
+	{  150,    75,  2271, 14},
+	{  225,    75,  1802, 16},
+	{  225,    75,  2271, 16},
+	{  375,    75,  1802, 26},
+	{  375,    75,  2271, 26},
+	{  450,    75,  1802, 19},
+	{  450,    75,  2271, 19},
+	{  600,    75,  1802, 20},
+	{  600,    75,  2271, 20},
+	{  675,    75,  1802, 19},
+	{  675,    75,  2271, 19},
+	{  750,    75,  1802, 15},
+	{  750,    75,  2271, 15},
+	{  825,    75,  1802, 10},
+	{  825,    75,  2271, 10},
+	{  900,    75,  1802, 21},
+	{  900,    75,  2271, 21},
+	{ 1050,    75,  1802, 25},
+	{ 1050,    75,  2271, 25}
+};
+
+const CToneEvent tetris_tone_over[1] = {
+	{    0,     0,     0,  0}
+};
+
+const CToneEvent tetris_tone_select[3] = {
+	{    0,    75,  2023, 25},
+	{   40,    75,  4046, 25},
+	{   40,    75,  6062, 25}
+};
+
+const CToneEvent tetris_tone_singleline[2] = {
+	{    0,    75,  4286, 25},
+	{   40,   120,  5401, 25}
+};
+
+const CToneEvent tetris_tone_success[3] = {
+	{    0,   300,  5722, 31},
+	{  200,   300,  7209, 31},
+	{  369,   800,  5722, 31}
+};
+
+const CToneEvent tetris_tone_title[94] = {
+	{    0,   214,   675, 31},
+	{    0,   428,  4046, 31},
+	{    0,   428,  5401, 31},
+	{    0,   428,  5401, 31},
+	{  214,   214,  1350, 31},
+	{  428,   214,   675, 31},
+	{  428,   214,  3402, 31},
+	{  428,   214,  4046, 31},
+	{  428,   214,  4046, 31},
+	{  642,   215,  1350, 31},
+	{  642,   215,  3604, 31},
+	{  642,   215,  4286, 31},
+	{  642,   215,  4286, 31},
+	{  857,   214,   675, 31},
+	{  857,   214,  4811, 31},
+	{  857,   214,  4811, 31},
+	{  857,   428,  4046, 31},
+	{ 1071,   107,  5401, 31},
+	{ 1071,   107,  5401, 31},
+	{ 1071,   214,  1350, 31},
+	{ 1178,   107,  4811, 31},
+	{ 1178,   107,  4811, 31},
+	{ 1285,   214,   675, 31},
+	{ 1285,   214,  3604, 31},
+	{ 1285,   214,  4286, 31},
+	{ 1285,   214,  4286, 31},
+	{ 1499,   215,  1350, 31},
+	{ 1499,   215,  3402, 31},
+	{ 1499,   215,  4046, 31},
+	{ 1499,   215,  4046, 31},
+	{ 1714,   214,   901, 31},
+	{ 1714,   428,  2700, 31},
+	{ 1714,   428,  3604, 31},
+	{ 1714,   428,  3604, 31},
+	{ 1928,   214,  1802, 31},
+	{ 2142,   215,   901, 31},
+	{ 2142,   215,  2700, 31},
+	{ 2142,   215,  3604, 31},
+	{ 2142,   215,  3604, 31},
+	{ 2357,   214,  1802, 31},
+	{ 2357,   214,  3604, 31},
+	{ 2357,   214,  4286, 31},
+	{ 2357,   214,  4286, 31},
+	{ 2571,   214,   901, 31},
+	{ 2571,   428,  4286, 31},
+	{ 2571,   428,  5401, 31},
+	{ 2571,   428,  5401, 31},
+	{ 2785,   214,  1802, 31},
+	{ 2999,   215,   901, 31},
+	{ 2999,   215,  4046, 31},
+	{ 2999,   215,  4811, 31},
+	{ 2999,   215,  4811, 31},
+	{ 3214,   214,  1802, 31},
+	{ 3214,   214,  3604, 31},
+	{ 3214,   214,  4286, 31},
+	{ 3214,   214,  4286, 31},
+	{ 3428,   214,  1011, 31},
+	{ 3428,   214,  3402, 31},
+	{ 3428,   429,  4046, 31},
+	{ 3428,   429,  4046, 31},
+	{ 3642,   215,  2023, 31},
+	{ 3642,   215,  2700, 31},
+	{ 3857,   214,  3402, 31},
+	{ 3857,   214,  4046, 31},
+	{ 3857,   214,  4046, 31},
+	{ 4071,   214,  2023, 31},
+	{ 4071,   214,  3604, 31},
+	{ 4071,   214,  4286, 31},
+	{ 4071,   214,  4286, 31},
+	{ 4285,   214,  4046, 31},
+	{ 4285,   429,  4811, 31},
+	{ 4285,   429,  4811, 31},
+	{ 4499,   215,  1350, 31},
+	{ 4499,   215,  3402, 31},
+	{ 4714,   214,  4286, 31},
+	{ 4714,   428,  5401, 31},
+	{ 4714,   428,  5401, 31},
+	{ 4928,   214,  1701, 31},
+	{ 4928,   214,  3402, 31},
+	{ 5142,   215,   901, 31},
+	{ 5142,   215,  3604, 31},
+	{ 5142,   429,  4286, 31},
+	{ 5142,   429,  4286, 31},
+	{ 5357,   214,  1350, 31},
+	{ 5357,   214,  2700, 31},
+	{ 5571,   214,   901, 31},
+	{ 5571,   428,  2700, 31},
+	{ 5571,   428,  3604, 31},
+	{ 5571,   428,  3604, 31},
+	{ 5785,   214,  1350, 31},
+	{ 5999,   429,   901, 31},
+	{ 5999,   429,  2700, 31},
+	{ 5999,   429,  3604, 31},
+	{ 5999,   429,  3604, 31}
+};
+
+const CToneEvent tetris_tone_undrop[3] = {
+	{    5,    65,  1430, 25},
+	{   65,    65,  1802, 25},
+	{   65,    65,  3604, 21}
+};
+#endif /* __TETRIS_TONE_RENDERER__ */
 
 
 /*
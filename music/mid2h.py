@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+#
+# mid2h.py
+#
+# Turns the sound effects of this folder into TetrisResDef.h:
+#
+#     python3 music/mid2h.py music ../TetrisResDef.h [name.mid ...]
+#
+# Every effect becomes a const array in ROM with a tetris_sfx_<name>_size
+# define. Effects with identical content are stored once, the others are
+# defined to the first one. What every effect costs is printed and kept in
+# the header.
+#
+# Every effect is also pre-parsed into a note list sorted by start time,
+# tetris_tone_<name>, which the optional tone renderer of Tetris.c plays
+# without parsing the SMF again (__TETRIS_TONE_RENDERER__).
+#
+# Replaces res2h.cmd and bin2c.exe, needs nothing but a Python 3 interpreter.
+#
+
+import glob
+import os
+import struct
+import sys
+
+TONE_SAMPLE_RATE = 8000     # TONE_SAMPLE_RATE of TetrisDefs.h
+
+HEADER = """/*
+** ===========================================================================
+**
+** File: 
+**     TetrisResDef.h
+**
+** Description: 
+**     Tetris Resource Definitions, generated by music/mid2h.py from the
+**     MIDI files in music, do not edit.
+** 
+** History: 
+**
+** when          who             what, where, why
+** ----------    ------------    --------------------------------
+** 2026-10-19    me              Pre-parsed tone lists.
+** 2026-10-19    me              Generated, shared effects stored once.
+** 2024-11-24	 me				 Success snd
+** 2024-11-24    me              Alignment.
+** 2024-11-22    me              Created.
+**
+** ===========================================================================
+*/
+
+#ifndef _GAME_TETRIS_RES_DEF_H_
+#define _GAME_TETRIS_RES_DEF_H_
+/* 
+**----------------------------------------------------------------------------
+**  Includes
+**---------------------------------------------------------------------------- 
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Variable Declarations
+**----------------------------------------------------------------------------
+*/
+
+"""
+
+FOOTER = """
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+#endif /* _GAME_TETRIS_RES_DEF_H_ */ 
+"""
+
+
+def read_var(data, pos):
+    value = 0
+    while True:
+        b = data[pos]
+        pos += 1
+        value = (value << 7) | (b & 0x7F)
+        if b < 0x80:
+            return value, pos
+
+def parse_notes(data):
+    """Returns the notes of a SMF as (start ms, length ms, note, velocity), sorted."""
+    fmt, tracks, division = struct.unpack(">HHH", data[8:14])
+    pos = 8 + struct.unpack(">I", data[4:8])[0]
+    tempos = []
+    events = []
+    for _ in range(tracks):
+        size = struct.unpack(">I", data[pos + 4:pos + 8])[0]
+        end = pos + 8 + size
+        pos += 8
+        tick = 0
+        status = 0
+        while pos < end:
+            delta, pos = read_var(data, pos)
+            tick += delta
+            if data[pos] >= 0x80:
+                status = data[pos]
+                pos += 1
+            if status == 0xFF:
+                kind = data[pos]
+                length, pos = read_var(data, pos + 1)
+                if kind == 0x51:
+                    tempos.append((tick, (data[pos] << 16) | (data[pos + 1] << 8) | data[pos + 2]))
+                pos += length
+                if kind == 0x2F:
+                    break
+            elif status in (0xF0, 0xF7):
+                length, pos = read_var(data, pos)
+                pos += length
+            else:
+                kind = status & 0xF0
+                count = 1 if kind in (0xC0, 0xD0) else 2
+                args = data[pos:pos + count]
+                pos += count
+                if kind in (0x80, 0x90) and (status & 0x0F) != 9:
+                    events.append((tick, status & 0x0F, args[0], args[1] if kind == 0x90 else 0))
+        pos = end
+    tempos.sort()
+    def ms(t):
+        total, last, tempo = 0.0, 0, 500000
+        for at, value in tempos:
+            if at >= t:
+                break
+            total += (at - last) * tempo / division
+            last, tempo = at, value
+        return (total + (t - last) * tempo / division) / 1000.0
+    events.sort(key=lambda e: (e[0], e[3] != 0))
+    notes = []
+    started = {}
+    for tick, channel, note, velocity in events:
+        key = (channel, note)
+        if key in started:
+            begin, vel = started.pop(key)
+            notes.append((int(ms(begin)), max(1, int(ms(tick)) - int(ms(begin))), note, vel))
+        if velocity:
+            started[key] = (tick, velocity)
+    notes.sort()
+    return notes
+
+
+def tone_events(notes):
+    """The CToneEvent lines of a note list: start, length, phase step, volume."""
+    events = []
+    for start, length, note, velocity in notes:
+        hz = 440.0 * 2 ** ((note - 69) / 12.0)
+        step = min(32767, int(round(hz * 65536 / TONE_SAMPLE_RATE)))
+        events.append((min(start, 0xFFFF), min(length, 0xFFFF), step, velocity >> 2))
+    return events
+
+
+def tone_name(symbol):
+    return symbol.replace("tetris_sfx_", "tetris_tone_")
+
+
+def main(argv):
+    if len(argv) < 3:
+        print("usage: mid2h.py <folder> TetrisResDef.h [name.mid ...]")
+        return 1
+    folder, out_path = argv[1], argv[2]
+    files = argv[3:] or sorted(os.path.basename(f) for f in glob.glob(os.path.join(folder, "*.mid")))
+
+    sounds = []
+    owners = {}
+    for name in files:
+        data = open(os.path.join(folder, name), "rb").read()
+        symbol = "tetris_sfx_" + os.path.splitext(name)[0].lower()
+        sounds.append((name, symbol, data, owners.setdefault(data, symbol)))
+
+    # what every effect costs, a shared one costs nothing
+    report = []
+    total = 0
+    for name, symbol, data, owner in sounds:
+        cost = len(data) if owner == symbol else 0
+        total += cost
+        report.append("%-16s %5d bytes%s, %d notes" % (name, cost, "" if owner == symbol else ", shares " + owner,
+                                                        len(parse_notes(data))))
+    report.append("%-16s %5d bytes, %d effects, %d stored"
+                  % ("total", total, len(sounds), len(set(owners.values()))))
+
+    out = open(out_path, "w", newline="\r\n")
+    out.write(HEADER)
+    out.write("/*\n" + "".join("** %s\n" % line for line in report) + "*/\n\n")
+    for name, symbol, data, owner in sounds:
+        out.write("#define %s_size %d\n" % (symbol, len(data)))
+    for name, symbol, data, owner in sounds:
+        if owner != symbol:
+            out.write("#define %s %s\n" % (symbol, owner))
+    out.write("\n")
+
+    for name, symbol, data, owner in sounds:
+        if owner != symbol:
+            continue
+        out.write("/* Contents of file %s */\n__align(2)\n\tconst U8 %s[%d] = {\n" % (name, symbol, len(data)))
+        lines = []
+        for i in range(0, len(data), 16):
+            lines.append("\t    " + ", ".join("0x%02X" % b for b in data[i:i + 16]))
+        out.write(",\n".join(lines) + "\n\t};\n\n")
+
+    # the same effects as note lists for the tone renderer, start and length in ms
+    out.write("#ifdef __TETRIS_TONE_RENDERER__\n")
+    for name, symbol, data, owner in sounds:
+        out.write("#define %s_count %d\n" % (tone_name(symbol), len(parse_notes(data))))
+    for name, symbol, data, owner in sounds:
+        if owner != symbol:
+            out.write("#define %s %s\n" % (tone_name(symbol), tone_name(owner)))
+    for name, symbol, data, owner in sounds:
+        if owner != symbol:
+            continue
+        events = tone_events(parse_notes(data)) or [(0, 0, 0, 0)]
+        out.write("\nconst CToneEvent %s[%d] = {\n" % (tone_name(symbol), len(events)))
+        out.write(",\n".join("\t{%5d, %5d, %5d, %2d}" % e for e in events) + "\n};\n")
+    out.write("#endif /* __TETRIS_TONE_RENDERER__ */\n")
+    out.write(FOOTER)
+    out.close()
+
+    print("\n".join(report))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -1,2 +1,2 @@
-for %%x in (*.mid) do bin2c -o %%x.h %%x
-pause
\ No newline at end of file
+python mid2h.py . ..\TetrisResDef.h
+pause
@@ -0,0 +1,272 @@
+/*
+** ===========================================================================
+**
+** File: 
+**     tonebench.c
+**
+** Description: 
+**     Host side comparison of the two ways Tetris.c starts an effect:
+**
+**         cc -O2 -o tonebench music/tonebench.c && ./tonebench music/blink.mid ...
+**
+**     smf     what has to happen on every play of the SMF path before the
+**             first sample: parse the file into a sorted note list.
+**     render  what the tone renderer does on every play: fill a ring slot
+**             from the note list music/mid2h.py made at build time, the
+**             loop of renderTheTones in Tetris.c.
+**
+**     The smf column leaves out what the driver does after the parse, the
+**     device numbers come from drv_get_current_time() around
+**     flushTheSound. A repeated effect finds its slot rendered already and
+**     costs nothing.
+** 
+** History: 
+**
+** when          who             what, where, why
+** ----------    ------------    --------------------------------
+** 2026-10-19    me              Created.
+**
+** ===========================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define TONE_SAMPLE_RATE    8000    // TetrisDefs.h
+#define TONE_SLOT_SAMPLES   10000
+#define TONE_WAV_HEADER     44
+#define MAX_NOTES           512
+#define MAX_TEMPOS          32
+#define FRAME_US            20000   // SOUND_FRAME_TIME
+
+typedef struct
+{
+    unsigned short  start;
+    unsigned short  length;
+    unsigned short  step;
+    unsigned char   volume;
+    unsigned char   reserved;
+} CToneEvent;
+
+typedef struct
+{
+    unsigned long   tick;
+    int             channel;
+    int             note;
+    int             velocity;       // 0 is a note off
+} CMidiEvent;
+
+static CMidiEvent   events[MAX_NOTES * 2];
+static CToneEvent   tones[MAX_NOTES];
+static unsigned long tempoTick[MAX_TEMPOS], tempoValue[MAX_TEMPOS];
+static unsigned char ring[TONE_WAV_HEADER + TONE_SLOT_SAMPLES];
+
+static unsigned long readVar( const unsigned char *data, long *pos)
+{
+    unsigned long value = 0;
+    unsigned char b;
+    do
+    {
+        b = data[(*pos)++];
+        value = ( value << 7) | ( b & 0x7f);
+    } while( b & 0x80);
+    return value;
+}
+
+static unsigned long readBig( const unsigned char *p, int bytes)
+{
+    unsigned long value = 0;
+    while( bytes--)
+        value = ( value << 8) | *p++;
+    return value;
+}
+
+static int byTick( const void *a, const void *b)
+{
+    const CMidiEvent *x = a, *y = b;
+    if( x->tick != y->tick)
+        return x->tick < y->tick ? -1 : 1;
+    return ( x->velocity != 0) - ( y->velocity != 0);   // offs first
+}
+
+static int byStart( const void *a, const void *b)
+{
+    const CToneEvent *x = a, *y = b;
+    return x->start != y->start ? x->start - y->start : x->step - y->step;
+}
+
+static unsigned long tickToMs( unsigned long tick, int tempos, unsigned long division)
+{
+    double total = 0;
+    unsigned long last = 0, tempo = 500000;
+    int i;
+    for( i = 0; i < tempos && tempoTick[i] < tick; i++)
+    {
+        total += ( double)( tempoTick[i] - last) * tempo / division;
+        last  = tempoTick[i];
+        tempo = tempoValue[i];
+    }
+    return ( unsigned long)(( total + ( double)( tick - last) * tempo / division) / 1000);
+}
+
+/* The SMF path: the same parse music/mid2h.py does, returns the note count. */
+static int parseTheSmf( const unsigned char *data, long size)
+{
+    int tracks = ( int)readBig( data + 10, 2);
+    unsigned long division = readBig( data + 12, 2);
+    long pos = 8 + ( long)readBig( data + 4, 4);
+    int count = 0, tempos = 0, notes = 0, i, j;
+
+    while( tracks-- > 0 && pos + 8 <= size)
+    {
+        long end = pos + 8 + ( long)readBig( data + pos + 4, 4);
+        unsigned long tick = 0;
+        int status = 0;
+        pos += 8;
+        while( pos < end)
+        {
+            tick += readVar( data, &pos);
+            if( data[pos] & 0x80)
+                status = data[pos++];
+            if( status == 0xff)
+            {
+                int kind = data[pos++];
+                unsigned long length = readVar( data, &pos);
+                if( kind == 0x51 && tempos < MAX_TEMPOS)
+                {
+                    tempoTick[tempos]    = tick;
+                    tempoValue[tempos++] = readBig( data + pos, 3);
+                }
+                pos += length;
+                if( kind == 0x2f)
+                    break;
+            }
+            else if( status == 0xf0 || status == 0xf7)
+            {
+                pos += readVar( data, &pos);
+            }
+            else
+            {
+                int kind = status & 0xf0;
+                if(( kind == 0x80 || kind == 0x90) && ( status & 0x0f) != 9 && count < MAX_NOTES * 2)
+                {
+                    events[count].tick     = tick;
+                    events[count].channel  = status & 0x0f;
+                    events[count].note     = data[pos];
+                    events[count].velocity = kind == 0x90 ? data[pos + 1] : 0;
+                    count++;
+                }
+                pos += ( kind == 0xc0 || kind == 0xd0) ? 1 : 2;
+            }
+        }
+        pos = end;
+    }
+
+    qsort( events, count, sizeof( events[0]), byTick);
+    for( i = 0; i < count; i++)
+    {
+        if( events[i].velocity == 0)
+            continue;
+        for( j = i + 1; j < count; j++)
+        {
+            if( events[j].channel == events[i].channel && events[j].note == events[i].note)
+                break;
+        }
+        if( j < count && notes < MAX_NOTES)
+        {
+            unsigned long start = tickToMs( events[i].tick, tempos, division);
+            unsigned long stop  = tickToMs( events[j].tick, tempos, division);
+            double hz = 440.0 * pow( 2.0, ( events[i].note - 69) / 12.0);
+            unsigned long step = ( unsigned long)( hz * 65536 / TONE_SAMPLE_RATE + 0.5);
+            tones[notes].start  = ( unsigned short)start;
+            tones[notes].length = ( unsigned short)( stop > start ? stop - start : 1);
+            tones[notes].step   = ( unsigned short)( step > 32767 ? 32767 : step);
+            tones[notes].volume = ( unsigned char)( events[i].velocity >> 2);
+            notes++;
+        }
+    }
+    qsort( tones, notes, sizeof( tones[0]), byStart);
+    return notes;
+}
+
+/* The tone path, keep in step with renderTheTones. */
+static unsigned long renderTheTones( const CToneEvent *list, int count)
+{
+    unsigned char *pcm = ring + TONE_WAV_HEADER;
+    unsigned long samples = 0, s, end;
+    unsigned short phase;
+    int i, value;
+
+    for( i = 0; i < count; i++)
+    {
+        end = ( unsigned long)( list[i].start + list[i].length) * TONE_SAMPLE_RATE / 1000;
+        if( end > samples)
+            samples = end;
+    }
+    if( samples == 0 || samples > TONE_SLOT_SAMPLES)
+        return 0;
+
+    memset( pcm, 0x80, samples);
+    for( i = 0; i < count; i++)
+    {
+        s     = ( unsigned long)list[i].start * TONE_SAMPLE_RATE / 1000;
+        end   = ( unsigned long)( list[i].start + list[i].length) * TONE_SAMPLE_RATE / 1000;
+        phase = 0;
+        for( ; s < end; s++, phase += list[i].step)
+        {
+            value = pcm[s] + (( phase & 0x8000) ? -list[i].volume : list[i].volume);
+            pcm[s] = ( unsigned char)( value < 0 ? 0 : ( value > 255 ? 255 : value));
+        }
+    }
+    return TONE_WAV_HEADER + samples;
+}
+
+static double nowUs( void)
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+int main( int argc, char **argv)
+{
+    static unsigned char data[65536];
+    int runs = 200, i, r, notes = 0;
+
+    printf( "%-24s %5s %10s %10s %8s\n", "effect", "notes", "smf us", "render us", "wav");
+    for( i = 1; i < argc; i++)
+    {
+        FILE *file = fopen( argv[i], "rb");
+        long size;
+        double start, smf, render;
+        unsigned long wav = 0;
+
+        if( file == NULL)
+        {
+            perror( argv[i]);
+            return 1;
+        }
+        size = ( long)fread( data, 1, sizeof( data), file);
+        fclose( file);
+
+        start = nowUs();
+        for( r = 0; r < runs; r++)
+            notes = parseTheSmf( data, size);
+        smf = ( nowUs() - start) / runs;
+
+        start = nowUs();
+        for( r = 0; r < runs; r++)
+            wav = renderTheTones( tones, notes);
+        render = ( nowUs() - start) / runs;
+
+        if( wav == 0)
+            printf( "%-24s %5d %10.2f %10s %8s\n", argv[i], notes, smf, "-", "SMF path");
+        else
+            printf( "%-24s %5d %10.2f %10.2f %8lu\n", argv[i], notes, smf, render, wav);
+    }
+    printf( "a frame is %d us on the device\n", FRAME_US);
+    return 0;
+}